@@ -0,0 +1,583 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+// Generates scaled instances, runs gringo, clingo and oclingo on them and
+// records wall time, instances (via --gstats-csv), peak resident memory and
+// the throughput of the written output.
+// Results can be saved as a baseline and compared against it later:
+//
+//   gringo-bench --save=baseline.csv
+//   gringo-bench --baseline=baseline.csv --threshold=0.1
+
+#include <boost/asio.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define foreach BOOST_FOREACH
+
+namespace
+{
+	enum Phase { GROUND, SOLVE, ONLINE };
+
+	struct Options
+	{
+		Options() : threshold(0.1), scale(1), repeat(1), port(25300) { }
+
+		std::string bin;
+		std::string dir;
+		std::string baseline;
+		std::string save;
+		std::string filter;
+		double      threshold;
+		int         scale;
+		int         repeat;
+		int         port;
+	};
+
+	struct Result
+	{
+		Result() : time(0), instances(0), rss(0), bytes(0), ok(true) { }
+
+		double   time;
+		uint64_t instances;
+		//! peak resident set size in KB (ru_maxrss)
+		long     rss;
+		//! size of the standard output of a run
+		uint64_t bytes;
+		bool     ok;
+	};
+
+	typedef void (*Generator)(std::ostream &out, int n);
+	typedef std::map<std::string, Result> Baseline;
+
+	struct Benchmark
+	{
+		const char *name;
+		Phase       phase;
+		Generator   generate;
+		int         size;
+	};
+
+	double now()
+	{
+		timeval tv;
+		gettimeofday(&tv, 0);
+		return tv.tv_sec + tv.tv_usec * 1e-6;
+	}
+
+	//! output throughput in MB/s
+	double throughput(const Result &res)
+	{
+		return res.time > 0 ? res.bytes / res.time / 1e6 : 0;
+	}
+
+	//! deterministic pseudo random numbers so that instances are reproducible
+	class Random
+	{
+	public:
+		Random(uint32_t seed) : state_(seed) { }
+		uint32_t operator()(uint32_t n) { state_ = state_ * 1103515245u + 12345u; return (state_ >> 8) % n; }
+	private:
+		uint32_t state_;
+	};
+
+	////////////////////////////// Generators //////////////////////////////
+
+	void queens(std::ostream &out, int n)
+	{
+		out << "#hide.\n";
+		out << "#show q/2.\n";
+		out << "num(1.." << n << ").\n";
+		out << "1 { q(X,Y) : num(Y) } 1 :- num(X).\n";
+		out << ":- q(X1,Y), q(X2,Y), X1 < X2.\n";
+		out << ":- q(X1,Y1), q(X2,Y2), X1 < X2, #abs(X1-X2) == #abs(Y1-Y2).\n";
+	}
+
+	void closure(std::ostream &out, int n)
+	{
+		Random rand(n);
+		for(int i = 1; i <= n; i++)
+		{
+			out << "edge(" << i << "," << (i % n) + 1 << ").\n";
+			out << "edge(" << i << "," << rand(n) + 1 << ").\n";
+			out << "edge(" << i << "," << rand(n) + 1 << ").\n";
+		}
+		out << "tc(X,Y) :- edge(X,Y).\n";
+		out << "tc(X,Z) :- tc(X,Y), edge(Y,Z).\n";
+	}
+
+	void grid(std::ostream &out, int n)
+	{
+		out << "#hide.\n";
+		out << "#show block/2.\n";
+		out << "cell(1.." << n << ",1.." << n << ").\n";
+		out << "adj(X,Y,X+1,Y) :- cell(X,Y), X < " << n << ".\n";
+		out << "adj(X,Y,X,Y+1) :- cell(X,Y), Y < " << n << ".\n";
+		out << "adj(X1,Y1,X,Y) :- adj(X,Y,X1,Y1).\n";
+		out << "start(1,1).\n";
+		out << "{ block(X,Y) } :- cell(X,Y), not start(X,Y).\n";
+		out << "reach(X,Y) :- start(X,Y).\n";
+		out << "reach(X1,Y1) :- reach(X,Y), adj(X,Y,X1,Y1), not block(X1,Y1).\n";
+		out << ":- not reach(" << n << "," << n << ").\n";
+		out << ":- #count{ block(X,Y) : cell(X,Y) } " << n - 1 << ".\n";
+	}
+
+	//! cyclic rule bodies whose partial matches mostly fail (see tests/clique.lp)
+	void clique(std::ostream &out, int n)
+	{
+		out << "#hide.\n";
+		out << "#show clique/4.\n";
+		out << "node(1.." << n << ").\n";
+		out << "edge(X,Y) :- node(X;Y), X < Y, (X*7919 + Y*104729) #mod 100 < 30.\n";
+		out << "triangle(X,Y,Z) :- edge(X,Y), edge(Y,Z), edge(X,Z).\n";
+		out << "clique(W,X,Y,Z) :- edge(W,X), edge(W,Y), edge(W,Z), edge(X,Y), edge(X,Z), edge(Y,Z).\n";
+	}
+
+	void aggregates(std::ostream &out, int n)
+	{
+		out << "#hide.\n";
+		out << "#show pick/1.\n";
+		out << "item(1.." << n << ").\n";
+		out << "weight(I,I #mod 13 + 1) :- item(I).\n";
+		out << "group(I,I #mod 10) :- item(I).\n";
+		out << "{ pick(I) } :- item(I).\n";
+		out << ":- #sum[ pick(I) = W : weight(I,W) ] " << 3 * n << ".\n";
+		out << ":- #count{ pick(I) : item(I) } " << n / 4 - 1 << ".\n";
+		out << "covered(G) :- group(_,G), 2 #count{ pick(I) : group(I,G) }.\n";
+		out << ":- group(_,G), not covered(G).\n";
+		out << "high(G) :- group(_,G), " << n / 2 << " #max[ pick(I) = I : group(I,G) ].\n";
+	}
+
+	//! a large ground program with little grounding work so that writing the output dominates
+	void output(std::ostream &out, int n)
+	{
+		out << "node(1.." << n << ").\n";
+		out << "{ in(X) } :- node(X).\n";
+		out << "out(X,Y) :- node(X;Y), X != Y, in(X), not in(Y).\n";
+	}
+
+	//! base program for oclingo; the controller sends obs/2 facts for each step
+	void online(std::ostream &out, int)
+	{
+		out << "#base.\n";
+		out << "node(1..100).\n";
+		out << "edge(X,X+1) :- node(X), X < 100.\n";
+		out << "edge(100,1).\n";
+		out << "#cumulative t.\n";
+		out << "#external obs(X,t) : node(X).\n";
+		out << "seen(X,t) :- obs(X,t).\n";
+		out << "seen(Y,t) :- seen(X,t), edge(X,Y).\n";
+		out << "{ alarm(X,t) } :- seen(X,t).\n";
+		out << ":- alarm(X,t), alarm(Y,t), X < Y.\n";
+		out << "#volatile t.\n";
+		out << ":- not 1 { alarm(X,t) : node(X) }.\n";
+	}
+
+#ifdef WITH_LUASQL
+	//! looks up one row per ground atom in an sqlite table, either via a prepared statement or a concatenated query
+	void luasql(std::ostream &out, int n, bool prepare)
+	{
+		out << "#begin_lua\n";
+		out << "local con = luasql.sqlite3():connect(\":memory:\")\n";
+		out << "con:execute(\"CREATE TABLE t(a INTEGER PRIMARY KEY, b INTEGER)\")\n";
+		out << "for i = 1, " << n << " do con:execute(\"INSERT INTO t VALUES (\" .. i .. \",\" .. i % 97 .. \")\") end\n";
+		if(prepare)
+		{
+			out << "local stmt = con:prepare(\"SELECT b FROM t WHERE a = ?\")\n";
+			out << "function lookup(x) return stmt:execute(x):fetch() end\n";
+		}
+		else
+		{
+			out << "function lookup(x)\n";
+			out << "\tlocal cur = con:execute(\"SELECT b FROM t WHERE a = \" .. x)\n";
+			out << "\tlocal b = cur:fetch()\n";
+			out << "\tcur:close()\n";
+			out << "\treturn b\n";
+			out << "end\n";
+		}
+		out << "#end_lua.\n";
+		out << "#hide.\n";
+		out << "key(1.." << n << ").\n";
+		out << "val(X,@lookup(X)) :- key(X).\n";
+	}
+
+	void sqlPrepare(std::ostream &out, int n) { luasql(out, n, true); }
+	void sqlExecute(std::ostream &out, int n) { luasql(out, n, false); }
+#endif
+
+	std::string onlineStep(int step)
+	{
+		std::ostringstream oss;
+		oss << "#step " << step << ".\n";
+		oss << "obs(" << (step * 7) % 100 + 1 << "," << step << ").\n";
+		oss << "#endstep.\n";
+		return oss.str();
+	}
+
+	const Benchmark benchmarks[] =
+	{
+		{ "queens",     GROUND, queens,     20  },
+		{ "queens",     SOLVE,  queens,     8   },
+		{ "closure",    GROUND, closure,    100 },
+		{ "grid",       GROUND, grid,       20  },
+		{ "clique",     GROUND, clique,     60  },
+		{ "grid",       SOLVE,  grid,       10  },
+		{ "aggregates", GROUND, aggregates, 200 },
+		{ "aggregates", SOLVE,  aggregates, 50  },
+		{ "output",     GROUND, output,     250 },
+#ifdef WITH_LUASQL
+		{ "sqlprepare", GROUND, sqlPrepare, 5000 },
+		{ "sqlexecute", GROUND, sqlExecute, 5000 },
+#endif
+		{ "online",     ONLINE, online,     10  }
+	};
+
+	const char *phaseName(Phase phase)
+	{
+		switch(phase)
+		{
+			case GROUND: { return "ground"; }
+			case SOLVE:  { return "solve"; }
+			default:     { return "online"; }
+		}
+	}
+
+	////////////////////////////// Processes //////////////////////////////
+
+	pid_t spawn(const std::vector<std::string> &args, const std::string &out, const std::string &err)
+	{
+		pid_t pid = fork();
+		if(pid == 0)
+		{
+			int fdOut = open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			int fdErr = open(err.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if(fdOut < 0 || fdErr < 0) { _exit(127); }
+			dup2(fdOut, 1);
+			dup2(fdErr, 2);
+			std::vector<char*> argv;
+			foreach(const std::string &arg, args) { argv.push_back(const_cast<char*>(arg.c_str())); }
+			argv.push_back(0);
+			execv(argv[0], &argv[0]);
+			_exit(127);
+		}
+		if(pid < 0) { throw std::runtime_error(std::string("fork failed: ") + std::strerror(errno)); }
+		return pid;
+	}
+
+	//! waits for the process and records its peak memory usage
+	void finish(pid_t pid, Result &res)
+	{
+		int status;
+		rusage usage;
+		if(wait4(pid, &status, 0, &usage) != pid) { res.ok = false; return; }
+		res.rss = std::max(res.rss, usage.ru_maxrss);
+		// NOTE: clingo reports satisfiability via exit codes 10, 20 and 30
+		int code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+		if(code != 0 && code != 10 && code != 20 && code != 30) { res.ok = false; }
+	}
+
+	//! splits a csv line, fields may be quoted with embedded quotes doubled
+	std::vector<std::string> fields(const std::string &line)
+	{
+		std::vector<std::string> ret(1);
+		bool quoted = false;
+		for(std::string::size_type i = 0; i < line.size(); i++)
+		{
+			char c = line[i];
+			if(quoted)
+			{
+				if(c != '"') { ret.back().push_back(c); }
+				else if(i + 1 < line.size() && line[i + 1] == '"') { ret.back().push_back(c); i++; }
+				else { quoted = false; }
+			}
+			else if(c == '"') { quoted = true; }
+			else if(c == ',') { ret.push_back(std::string()); }
+			else { ret.back().push_back(c); }
+		}
+		return ret;
+	}
+
+	//! sums the instances column of the statement rows of a --gstats-csv file
+	uint64_t instances(const std::string &csv)
+	{
+		std::ifstream in(csv.c_str());
+		std::string line;
+		uint64_t sum = 0;
+		std::getline(in, line);
+		std::vector<std::string> header = fields(line);
+		std::vector<std::string>::size_type col = std::find(header.begin(), header.end(), "instances") - header.begin();
+		while(std::getline(in, line))
+		{
+			std::vector<std::string> row = fields(line);
+			if(col < row.size() && row[0] != "predicate") { sum += std::strtoull(row[col].c_str(), 0, 10); }
+		}
+		return sum;
+	}
+
+	////////////////////////////// Controller //////////////////////////////
+
+	//! stands in for an oclingo controller: sends one step at a time and waits for its answer
+	class Controller
+	{
+	public:
+		Controller(pid_t server, int port);
+		void send(const std::string &msg);
+		//! reads messages until oclingo asks for the next input
+		void endOfStep();
+	private:
+		boost::asio::io_service      io_;
+		boost::asio::ip::tcp::socket socket_;
+		boost::asio::streambuf       buf_;
+	};
+
+	Controller::Controller(pid_t server, int port)
+		: socket_(io_)
+	{
+		boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port);
+		for(int tries = 0; ; tries++)
+		{
+			boost::system::error_code ec;
+			socket_.connect(endpoint, ec);
+			if(!ec) { break; }
+			socket_.close();
+			int status;
+			if(tries > 200 || waitpid(server, &status, WNOHANG) == server) { throw std::runtime_error("could not connect to oclingo"); }
+			usleep(50000);
+		}
+	}
+
+	void Controller::send(const std::string &msg)
+	{
+		boost::asio::write(socket_, boost::asio::buffer(msg + char(0)));
+	}
+
+	void Controller::endOfStep()
+	{
+		for(;;)
+		{
+			boost::asio::read_until(socket_, buf_, char(0));
+			std::istream in(&buf_);
+			std::string msg;
+			std::getline(in, msg, char(0));
+			if(msg.compare(0, 12, "End of Step.") == 0) { return; }
+		}
+	}
+
+	////////////////////////////// Runs //////////////////////////////
+
+	void runOnce(const Options &opts, const Benchmark &b, const std::string &file, int size, Result &res)
+	{
+		std::string base = opts.dir + "/" + b.name + "-" + phaseName(b.phase) + "-" + boost::lexical_cast<std::string>(size);
+		std::vector<std::string> args;
+		double start = now();
+		if(b.phase == ONLINE)
+		{
+			args.push_back(opts.bin + "/oclingo");
+			args.push_back("--port=" + boost::lexical_cast<std::string>(opts.port));
+			args.push_back(file);
+			pid_t pid = spawn(args, base + ".out", base + ".err");
+			try
+			{
+				Controller ctrl(pid, opts.port);
+				for(int step = 1; step <= size; step++)
+				{
+					ctrl.endOfStep();
+					ctrl.send(onlineStep(step));
+				}
+				ctrl.endOfStep();
+				ctrl.send("#stop.\n");
+			}
+			catch(const std::exception &e)
+			{
+				std::cerr << "warning: " << b.name << "/" << size << ": " << e.what() << std::endl;
+				kill(pid, SIGTERM);
+				res.ok = false;
+			}
+			finish(pid, res);
+		}
+		else
+		{
+			args.push_back(opts.bin + (b.phase == GROUND ? "/gringo" : "/clingo"));
+			args.push_back(file);
+			finish(spawn(args, base + ".out", base + ".err"), res);
+		}
+		double time = now() - start;
+		res.time = res.time == 0 ? time : std::min(res.time, time);
+		struct stat st;
+		if(stat((base + ".out").c_str(), &st) == 0) { res.bytes = st.st_size; }
+	}
+
+	Result run(const Options &opts, const Benchmark &b, int size)
+	{
+		std::string file = opts.dir + "/" + b.name + "-" + boost::lexical_cast<std::string>(size) + ".lp";
+		{
+			std::ofstream out(file.c_str());
+			b.generate(out, size);
+		}
+		Result res;
+		for(int i = 0; i < opts.repeat && res.ok; i++) { runOnce(opts, b, file, size, res); }
+		if(res.ok && b.phase != ONLINE)
+		{
+			// instances are counted in a separate run because profiling slows grounding down
+			std::string csv = opts.dir + "/" + b.name + "-" + boost::lexical_cast<std::string>(size) + ".csv";
+			std::vector<std::string> args;
+			args.push_back(opts.bin + "/gringo");
+			args.push_back("--gstats-csv=" + csv);
+			args.push_back(file);
+			Result stats;
+			finish(spawn(args, "/dev/null", "/dev/null"), stats);
+			res.instances = instances(csv);
+		}
+		return res;
+	}
+
+	////////////////////////////// Baseline //////////////////////////////
+
+	Baseline load(const std::string &file)
+	{
+		Baseline baseline;
+		std::ifstream in(file.c_str());
+		if(!in) { throw std::runtime_error("could not open baseline: " + file); }
+		std::string line;
+		std::getline(in, line);
+		while(std::getline(in, line))
+		{
+			std::replace(line.begin(), line.end(), ',', ' ');
+			std::istringstream iss(line);
+			std::string key;
+			Result res;
+			if(iss >> key >> res.time >> res.instances >> res.rss) { baseline[key] = res; }
+		}
+		return baseline;
+	}
+
+	std::string compare(const Options &opts, const Result &res, const Result &base)
+	{
+		// a little absolute slack keeps very short runs from reporting timer noise
+		if(res.time > base.time * (1 + opts.threshold) + 0.01) { return "slower"; }
+		if(res.rss > base.rss * (1 + opts.threshold))          { return "more memory"; }
+		if(res.instances > base.instances)                     { return "more instances"; }
+		return "ok";
+	}
+
+	bool option(const std::string &arg, const char *name, std::string &value)
+	{
+		std::string prefix = std::string("--") + name + "=";
+		if(arg.compare(0, prefix.size(), prefix) != 0) { return false; }
+		value = arg.substr(prefix.size());
+		return true;
+	}
+
+	void usage(const char *name)
+	{
+		std::cerr
+			<< "usage: " << name << " [options]\n"
+			<< "  --bin=<dir>         directory with the gringo, clingo and oclingo binaries\n"
+			<< "  --dir=<dir>         directory for generated instances and outputs (default: .)\n"
+			<< "  --filter=<str>      only run benchmarks whose name contains <str>\n"
+			<< "  --scale=<num>       multiply the instance sizes by <num> (default: 1)\n"
+			<< "  --repeat=<num>      report the fastest of <num> runs (default: 1)\n"
+			<< "  --port=<num>        port for oclingo (default: 25300)\n"
+			<< "  --save=<file>       write the results as a baseline\n"
+			<< "  --baseline=<file>   compare against a baseline\n"
+			<< "  --threshold=<num>   tolerated relative regression (default: 0.1)\n";
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	Options opts;
+	std::string arg0(argv[0]);
+	opts.bin = arg0.find('/') == std::string::npos ? "." : arg0.substr(0, arg0.rfind('/'));
+	opts.dir = ".";
+	try
+	{
+		for(int i = 1; i < argc; i++)
+		{
+			std::string arg(argv[i]), value;
+			if(option(arg, "bin", value))            { opts.bin = value; }
+			else if(option(arg, "dir", value))       { opts.dir = value; }
+			else if(option(arg, "filter", value))    { opts.filter = value; }
+			else if(option(arg, "baseline", value))  { opts.baseline = value; }
+			else if(option(arg, "save", value))      { opts.save = value; }
+			else if(option(arg, "scale", value))     { opts.scale = boost::lexical_cast<int>(value); }
+			else if(option(arg, "repeat", value))    { opts.repeat = boost::lexical_cast<int>(value); }
+			else if(option(arg, "port", value))      { opts.port = boost::lexical_cast<int>(value); }
+			else if(option(arg, "threshold", value)) { opts.threshold = boost::lexical_cast<double>(value); }
+			else { usage(argv[0]); return 1; }
+		}
+
+		Baseline baseline;
+		if(!opts.baseline.empty()) { baseline = load(opts.baseline); }
+		std::ofstream save;
+		if(!opts.save.empty())
+		{
+			save.open(opts.save.c_str());
+			save << "benchmark,time,instances,rss,bytes" << std::endl;
+		}
+
+		bool regression = false;
+		std::cout << std::setiosflags(std::ios::left) << std::setw(24) << "benchmark" << std::resetiosflags(std::ios::left);
+		std::cout << std::setw(10) << "time[s]" << std::setw(12) << "instances" << std::setw(10) << "rss[KB]" << std::setw(10) << "MB/s" << "  status" << std::endl;
+		foreach(const Benchmark &b, benchmarks)
+		{
+			if(std::string(b.name).find(opts.filter) == std::string::npos) { continue; }
+			// each benchmark is run at three sizes to show how it scales
+			for(int factor = 1; factor <= 4; factor *= 2)
+			{
+				int size = b.size * opts.scale * factor;
+				std::string key = std::string(b.name) + "/" + phaseName(b.phase) + "/" + boost::lexical_cast<std::string>(size);
+				Result res = run(opts, b, size);
+				std::string status = "failed";
+				if(res.ok)
+				{
+					Baseline::iterator it = baseline.find(key);
+					status = opts.baseline.empty() ? "" : it == baseline.end() ? "new" : compare(opts, res, it->second);
+					if(save.is_open()) { save << key << "," << res.time << "," << res.instances << "," << res.rss << "," << res.bytes << std::endl; }
+				}
+				if(status != "" && status != "ok" && status != "new") { regression = true; }
+				std::cout << std::setiosflags(std::ios::left) << std::setw(24) << key << std::resetiosflags(std::ios::left);
+				std::cout << std::setw(10) << std::fixed << std::setprecision(3) << res.time << std::setw(12) << res.instances << std::setw(10) << res.rss << std::setw(10) << throughput(res) << "  " << status << std::endl;
+			}
+		}
+		return regression ? 1 : 0;
+	}
+	catch(const std::exception &e)
+	{
+		std::cerr << "error: " << e.what() << std::endl;
+		return 1;
+	}
+}
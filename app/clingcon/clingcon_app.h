@@ -193,6 +193,7 @@ CSPFromGringo<M>::CSPFromGringo(ClingconApp<M> &a, Streams& str, Clingcon::CSPSo
                 out.reset(new CSPOutput(app.gringo.disjShift, config, app.clingo.mode == ICLINGCON, cspsolver));
 	}
         else { otherOutput(config); }
+	out->simplify(app.gringo.simplify);
 	if(app.clingo.mode == CLINGCON && app.gringo.groundInput)
 	{
 		storage.reset(new Storage(out.get()));
@@ -242,6 +243,7 @@ bool CSPFromGringo<M>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int)
 			config.incStep++;
 			app.groundStep(*grounder, config, config.incStep, app.clingo.inc.iQuery);
 		}
+		grounder->printProfile(app.gringo.statsFile);
 	}
 
 	out->finalize();
@@ -397,6 +399,7 @@ int ClingconApp<M>::doRun()
                     g.analyze(gringo.depGraph, gringo.stats);
                     groundBase(g, config, 1, gringo.ifixed, gringo.ifixed);
                     o->finalize();
+                    g.printProfile(gringo.statsFile);
             }
 
             return EXIT_SUCCESS;
@@ -534,17 +537,28 @@ void ClingconApp<M>::event(Clasp::ClaspFacade::Event e, Clasp::ClaspFacade& f)
                     const Clingcon::CSPSolver::ConstraintMap& m = cspsolver_->getConstraints();
                     for(Clingcon::CSPSolver::ConstraintMap::const_iterator i = m.begin(); i != m.end(); ++i)
                         solver_.setFrozen(f.api()->getLiteral(i->first.index()).var(),true);
+                    // so are the atoms reified global constraints are posted on
+                    const Clingcon::LParseGlobalConstraintPrinter::GCvec& g = cspsolver_->getGlobalConstraints();
+                    for(Clingcon::LParseGlobalConstraintPrinter::GCvec::const_iterator i = g.begin(); i != g.end(); ++i)
+                        if (i->atom_)
+                            solver_.setFrozen(f.api()->getLiteral(i->atom_).var(),true);
                     //über csp atom liste rüber gehen und solver atoms setFrozen(var,true)
                             //programbuilder hat getLiteral, liefert literal im solver-> var
                     cspsolver_->setSolver(&solver_);
-                    cp_ = new Clingcon::ClingconPropagator(cspsolver_.get());
-                    solver_.addPost(cp_);
+                    // the propagator and the root space are kept over incremental steps
+                    if (!cp_)
+                    {
+                        cp_ = new Clingcon::ClingconPropagator(cspsolver_.get());
+                        solver_.addPost(cp_);
+                    }
                     //cspsolver_->setDomain((dynamic_cast<FromGringo*>(in_.get()))->grounder->getCSPDomain().first,
                     //                         (dynamic_cast<FromGringo*>(in_.get()))->grounder->getCSPDomain().second);
                     //initialize cspsolver
                     cspsolver_->initialize();
                     if (f.api()->hasMinimize() && cspsolver_->hasOptimizeStm())
                         throw std::runtime_error("Can not optimize asp and csp at the same time!");
+                    // every new optimum of clasp bounds the constraint atoms of the minimize statement in gecode
+                    cspsolver_->setAspEnumerator(f.config()->solve.enumerator());
                     // set restart on model if we minimize in csp, otherwise i would have to implement an enumerator
                    /* if (cspsolver_->hasOptimizeStm())
                     {
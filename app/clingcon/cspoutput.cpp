@@ -50,6 +50,7 @@ void CSPOutput::initialize()
 
 void CSPOutput::printBasicRule(uint32_t head, const AtomVec &pos, const AtomVec &neg)
 {
+	markConstraints(pos, neg);
 	b_->startRule();
 	b_->addHead(head);
 	foreach(AtomVec::value_type atom, neg) { b_->addToBody(atom, false); }
@@ -59,6 +60,7 @@ void CSPOutput::printBasicRule(uint32_t head, const AtomVec &pos, const AtomVec
 
 void CSPOutput::printConstraintRule(uint32_t head, int bound, const AtomVec &pos, const AtomVec &neg)
 {
+	markConstraints(pos, neg);
 	b_->startRule(Clasp::CONSTRAINTRULE, bound);
 	b_->addHead(head);
 	foreach(AtomVec::value_type atom, neg) { b_->addToBody(atom, false); }
@@ -68,6 +70,7 @@ void CSPOutput::printConstraintRule(uint32_t head, int bound, const AtomVec &pos
 
 void CSPOutput::printChoiceRule(const AtomVec &head, const AtomVec &pos, const AtomVec &neg)
 {
+	markConstraints(pos, neg);
 	b_->startRule(Clasp::CHOICERULE);
 	foreach(AtomVec::value_type atom, head) { b_->addHead(atom); }
 	foreach(AtomVec::value_type atom, neg) { b_->addToBody(atom, false); }
@@ -77,6 +80,7 @@ void CSPOutput::printChoiceRule(const AtomVec &head, const AtomVec &pos, const A
 
 void CSPOutput::printWeightRule(uint32_t head, int bound, const AtomVec &pos, const AtomVec &neg, const WeightVec &wPos, const WeightVec &wNeg)
 {
+	markConstraints(pos, neg);
 	b_->startRule(Clasp::WEIGHTRULE, bound);
 	b_->addHead(head);
 	WeightVec::const_iterator itW = wNeg.begin();
@@ -90,6 +94,9 @@ void CSPOutput::printWeightRule(uint32_t head, int bound, const AtomVec &pos, co
 
 void CSPOutput::printMinimizeRule(const AtomVec &pos, const AtomVec &neg, const WeightVec &wPos, const WeightVec &wNeg)
 {
+	markConstraints(pos, neg);
+	// the statements of later steps would form other clasp minimize rules
+	if (!incremental_) { cspsolver_->setAspMinimize(pos, neg, wPos, wNeg); }
 	b_->startRule(Clasp::OPTIMIZERULE);
 	WeightVec::const_iterator itW = wNeg.begin();
 	for(AtomVec::const_iterator it = neg.begin(); it != neg.end(); it++, itW++)
@@ -143,10 +150,57 @@ uint32_t CSPOutput::symbol(const std::string& name, bool freeze)
         AtomVec vec;
         vec.push_back(atom);
         printChoiceRule(vec,AtomVec(),AtomVec());
+        // only constraint atoms are frozen
+        if (incremental_) { cspExpire_[atom] = -1; }
     }
     return atom;
 }
 
+void CSPOutput::markConstraints(const AtomVec &pos, const AtomVec &neg)
+{
+    if (cspExpire_.empty()) { return; }
+    int expire = std::numeric_limits<int>::max();
+    uint32_t step = 0;
+    foreach(AtomVec::value_type atom, neg)
+    {
+        ExpireMap::const_iterator it = volSteps_.find(atom);
+        if (it != volSteps_.end()) { expire = it->second; step = atom; break; }
+    }
+    foreach(AtomVec::value_type atom, neg) { markConstraint(atom, expire, step); }
+    foreach(AtomVec::value_type atom, pos) { markConstraint(atom, expire, step); }
+}
+
+void CSPOutput::markConstraint(uint32_t atom, int expire, uint32_t step)
+{
+    ExpireMap::iterator it = cspExpire_.find(atom);
+    if (it != cspExpire_.end() && it->second < expire)
+    {
+        it->second = expire;
+        if (expire != std::numeric_limits<int>::max()) { expireQueue_.insert(std::make_pair(expire, atom)); }
+        // all pending volatile atoms are assumed false together, so the latest step guards the constraint
+        cspsolver_->guardConstraint(atom, step);
+    }
+}
+
+void CSPOutput::retireConstraints()
+{
+    AtomVec retired;
+    ExpireQueue::iterator end = expireQueue_.upper_bound(config_.incStep);
+    for (ExpireQueue::iterator it = expireQueue_.begin(); it != end; it++)
+    {
+        // the atom might have been used by a rule that expires later
+        ExpireMap::iterator jt = cspExpire_.find(it->second);
+        if (jt != cspExpire_.end() && jt->second == it->first)
+        {
+            retired.push_back(it->second);
+            cspsolver_->retireConstraint(it->second);
+            cspExpire_.erase(jt);
+        }
+    }
+    expireQueue_.erase(expireQueue_.begin(), end);
+    static_cast<Clingcon::LParseCSPLitPrinter*>(storage()->output()->printer<Clingcon::CSPLit::Printer>())->forget(retired);
+}
+
 void CSPOutput::doFinalize()
 {
 	printSymbolTable();
@@ -155,8 +209,11 @@ void CSPOutput::doFinalize()
         for (VolMap::iterator it = volUids_.begin(); it != end; it++)
         {
             b_->startRule().addHead(it->second).endRule();
+            volSteps_.erase(it->second);
         }
         volUids_.erase(volUids_.begin(), end);
+        // constraints only used by expired volatile rules are removed from the csp
+        retireConstraints();
         // Note: make sure that there is always a volatile atom
         // this is important to prevent clasp from polluting its top level
         if (incremental_) { getVolAtom(1); }
@@ -170,6 +227,8 @@ void CSPOutput::doFinalize()
         {
             cspsolver_->addConstraint(i->second,i->first);
         }
+        // the solver owns the constraints now, only hand over new ones in the next step
+        constraints->clear();
 
         //Clingcon::LParseCSPDomainPrinter::Domains* domains = static_cast<Clingcon::LParseCSPDomainPrinter*>(storage()->output()->printer<Clingcon::CSPDomainLiteral::Printer>())->getDomains();
 
@@ -234,6 +293,7 @@ uint32_t CSPOutput::getNewVolUid(int step)
         {
             sym = symbol();
             b_->freeze(sym);
+            volSteps_[sym] = step;
         }
         return sym;
     }
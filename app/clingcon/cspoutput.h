@@ -31,6 +31,8 @@ protected:
         typedef std::map<int, uint32_t> VolMap;
         typedef boost::unordered_map<int, AtomVec> ExternalMap;
         typedef boost::unordered_map<Val, uint32_t> AssertMap;
+        typedef boost::unordered_map<uint32_t, int> ExpireMap;
+        typedef std::multimap<int, uint32_t> ExpireQueue;
 
 	typedef std::vector<bool> BoolVec;
 public:
@@ -60,6 +62,10 @@ protected:
         void printSymbolTableEntry(uint32_t symbol, const std::string &name);
         void printExternalTableEntry(const Symbol &symbol);
         using LparseConverter::symbol;
+        // constraint atoms in rule bodies guarded by a volatile atom expire with it
+        void markConstraints(const AtomVec &pos, const AtomVec &neg);
+        void markConstraint(uint32_t atom, int expire, uint32_t step);
+        void retireConstraints();
 
 	uint32_t symbol();
         uint32_t symbol(const std::string& name, bool freeze);
@@ -69,6 +75,9 @@ protected:
         IncConfig             &config_;
         bool                   initialized;
         VolMap                 volUids_;
+        ExpireMap              volSteps_;    // volatile atom -> step it expires
+        ExpireMap              cspExpire_;   // constraint atom -> step its last rule expires, -1 if unused
+        ExpireQueue            expireQueue_; // candidates for retirement, may be outdated
         AssertMap              assertUids_;
         ExternalMap            externalAtoms_;
         uint32_t               trueAtom_;
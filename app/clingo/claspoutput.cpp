@@ -179,6 +179,19 @@ uint32_t ClaspOutput::getVolAtom(int vol_window)
 	return getNewVolUid(config_.incStep + vol_window);
 }
 
+uint32_t ClaspOutput::frozenSymbol()
+{
+	if (!incremental_) { return 0; }
+	uint32_t sym = symbol();
+	b_->freeze(sym);
+	return sym;
+}
+
+void ClaspOutput::unfreezeSymbol(uint32_t sym)
+{
+	b_->unfreeze(sym);
+}
+
 uint32_t ClaspOutput::getAssertAtom(Val term)
 {
 	uint32_t &sym = assertUids_[term];
@@ -42,6 +42,8 @@ public:
 	void forgetStep(int step);
 	uint32_t getNewVolUid(int step);
 	uint32_t getVolAtom(int vol_window);
+	uint32_t frozenSymbol();
+	void unfreezeSymbol(uint32_t sym);
 	uint32_t getAssertAtom(Val term);
 	void retractAtom(Val term);
 	
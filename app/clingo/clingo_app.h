@@ -243,6 +243,7 @@ FromGringo<M>::FromGringo(ClingoApp<M> &a, Streams& str)
 		out.reset(new ClaspOutput(app.gringo.disjShift, config, app.clingo.mode == ICLINGO));
 	}
 	else { otherOutput(config); }
+	out->simplify(app.gringo.simplify);
 	if(app.clingo.mode == CLINGO && app.gringo.groundInput)
 	{
 		storage.reset(new Storage(out.get()));
@@ -293,6 +294,7 @@ bool FromGringo<M>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int)
 			config.incStep++;
 			app.groundStep(*grounder, config, config.incStep, app.clingo.inc.iQuery);
 		}
+		grounder->printProfile(app.gringo.statsFile);
 	}
 	out->finalize();
 	release();
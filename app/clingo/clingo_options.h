@@ -130,7 +130,11 @@ template <Mode M>
 bool ClingoOptions<M>::validateOptions(ProgramOptions::OptionValues& values, GringoOptions& opts, Messages& m)
 {
 	(void)values;
-	(void)opts;
+	if(!opts.saveState.empty() || !opts.loadState.empty())
+	{
+		m.error = "Options '--save-state' and '--load-state' are only supported by gringo";
+		return false;
+	}
 	if(M == ICLINGO || M == OCLINGO)
 	{
 		if (claspMode && clingoMode)
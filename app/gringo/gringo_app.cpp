@@ -24,6 +24,7 @@
 #include <gringo/plainoutput.h>
 #include <gringo/lparseoutput.h>
 #include <gringo/reifiedoutput.h>
+#include <gringo/snapshot.h>
 
 namespace
 {
@@ -41,7 +42,11 @@ Output *GringoApp::output() const
 	else if (gringo.textOut)
 		return new PlainOutput(std::cout);
 	else
-		return new LparseOutput(std::cout, gringo.disjShift);
+	{
+		LparseOutput *out = new LparseOutput(std::cout, gringo.disjShift);
+		out->simplify(gringo.simplify);
+		return out;
+	}
 }
 
 GringoApp& GringoApp::instance()
@@ -86,7 +91,13 @@ void GringoApp::groundStep(Grounder &g, IncConfig &cfg, int step, int goal)
 		{
 			std::cerr << "% grounding volatile " << cfg.incStep << " ..." << std::endl;
 		}
+		// atoms and aggregate states of the volatile part are only valid in this step,
+		// with a window they stay valid for the next steps whose cumulative atoms
+		// come after them in the domains, so they cannot be rolled back
+		bool rollback = cfg.maxVolStep == 1;
+		if(rollback) { g.mark(*volatile_); }
 		g.ground(*volatile_);
+		if(rollback) { g.rollback(*volatile_); }
 	}
 }
 
@@ -139,8 +150,24 @@ int GringoApp::doRun()
 		if(gringo.magic) g.addMagic();
 		g.analyze(gringo.depGraph, gringo.stats);
 		setIinit(config);
-		groundBase(g, config, gringo.iinit, gringo.ifixed, gringo.ifixed);
+		LparseConverter *conv = dynamic_cast<LparseConverter*>(o.get());
+		int step = gringo.iinit - 1;
+		if(!gringo.loadState.empty())
+		{
+			// the base and the saved steps are not grounded (and printed) again
+			std::ifstream in(gringo.loadState.c_str(), std::ios::binary);
+			if(!in) { throw std::runtime_error("could not open state file: " + gringo.loadState); }
+			step = Snapshot::load(in, &g, conv);
+			for(int i = step + 1; i <= gringo.ifixed; i++) { groundStep(g, config, i, gringo.ifixed); }
+		}
+		else { groundBase(g, config, gringo.iinit, gringo.ifixed, gringo.ifixed); }
 		o->finalize();
+		if(!gringo.saveState.empty())
+		{
+			std::ofstream out(gringo.saveState.c_str(), std::ios::binary);
+			Snapshot::save(out, &g, conv, std::max(step, gringo.ifixed));
+		}
+		g.printProfile(gringo.statsFile);
 	}
 
 	return EXIT_SUCCESS;
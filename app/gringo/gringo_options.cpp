@@ -31,6 +31,7 @@ bool HeuristicOptions::mapHeuristic(const std::string& s, HeuristicOptions &opti
 	std::string temp = toLower(s);
 	if (temp == "basic")      { options.heuristic.reset(new BasicBodyOrderHeuristic()); return true; }
 	else if (temp == "unify") { options.heuristic.reset(new UnifyBodyOrderHeuristic()); return true; }
+	else if (temp == "cost")  { options.heuristic.reset(new CostBodyOrderHeuristic()); return true; }
 	return false;
 }
 
@@ -63,6 +64,7 @@ GringoOptions::GringoOptions()
 	, iinit(1)
 	, groundInput(false)
 	, disjShift(false)
+	, simplify(false)
 	, compat(false)
 	, stats(false)
 	, magic(false)
@@ -79,6 +81,7 @@ void GringoOptions::initOptions(ProgramOptions::OptionGroup& root, ProgramOption
 	gringo.addOptions()
 		("const,c"   , storeTo(consts)->setComposing(), "Replace constant <c> by value <v>\n", "<c>=<v>")
 		("gstats"    , bool_switch(&stats),             "Print extended statistics")
+		("gstats-csv", storeTo(statsFile),              "Write grounding statistics to file (implies --gstats)", "<file>")
 		("dep-graph" , storeTo(depGraph),               "Dump program dependency graph to file", "<file>")
 
 		("text,t"    , bool_switch(&textOut),           "Print plain text format")
@@ -88,17 +91,21 @@ void GringoOptions::initOptions(ProgramOptions::OptionGroup& root, ProgramOption
 		("compat"    , bool_switch(&compat),            "Improve compatibility with lparse")
 		//("ground,g"  , bool_switch(&groundInput),       "Enable lightweight mode for ground input")
 		("shift"     , bool_switch(&disjShift),         "Shift disjunctions into the body")
+		("simplify"  , bool_switch(&simplify),          "Drop known literals and duplicate rules before output")
 		("body-order", storeTo(heuristics)->parser(&HeuristicOptions::mapHeuristic)->setImplicit(),
 			"Configure body order heuristic\n"
 			"      Default: basic\n"
-			"      Valid:   basic, unify\n"
+			"      Valid:   basic, unify, cost\n"
 			"        basic: basic heuristic\n"
-			"        unify: unify to estimate domain sizes")
+			"        unify: unify to estimate domain sizes\n"
+			"        cost : estimate matches using distinct values per argument")
 
 		("magic"     , bool_switch(&magic),             "Enable magic set rewriting")
 
 		("ifixed"    , storeTo(ifixed),                 "Fix number of incremental steps to <num>", "<num>")
 		("iinit"     , storeTo(iinit),                  "Start to ground from step <num>", "<num>")
+		("save-state", storeTo(saveState),              "Save the grounded atoms and steps to <file>", "<file>")
+		("load-state", storeTo(loadState),              "Continue grounding after the steps saved in <file>", "<file>")
 	;
 	OptionGroup basic("Basic Options");
 	root.addOptions(gringo);
@@ -108,6 +115,7 @@ void GringoOptions::initOptions(ProgramOptions::OptionGroup& root, ProgramOption
 bool GringoOptions::validateOptions(ProgramOptions::OptionValues& values, Messages& m)
 {
 	(void)values;
+	if(!statsFile.empty()) { stats = true; }
 	int out = smodelsOut + textOut + metaOut;
 	if (out > 1)
 	{
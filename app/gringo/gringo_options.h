@@ -66,11 +66,19 @@ public:
 	bool groundInput;
 	/** whether disjunctions will get shifted */
 	bool disjShift;
+	/** whether the ground program is simplified before output */
+	bool simplify;
 	/** filename for optional dependency graph dump */
 	std::string depGraph;
 	bool compat;
 	/** whether statistics will be printed to stderr */
 	bool stats;
+	/** filename for optional grounding statistics in csv format */
+	std::string statsFile;
+	/** filename the grounded atoms are saved to */
+	std::string saveState;
+	/** filename grounded atoms of an earlier run are loaded from */
+	std::string loadState;
 	/** whether magic set rewriting is enabled */
 	bool magic;
 	ProgramOptions::HeuristicOptions heuristics;
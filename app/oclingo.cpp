@@ -20,7 +20,14 @@
 template <>
 void FromGringo<OCLINGO>::otherOutput(IncConfig &config)
 {
-	out.reset(new oClaspOutput(grounder.get(), app.gringo.disjShift, config, app.oclingo.online.port, app.oclingo.online.import));
+	oClaspOutput *output = new oClaspOutput(grounder.get(), app.gringo.disjShift, config, app.oclingo.online.port, app.oclingo.online.import);
+	out.reset(output);
+	output->getExternalKnowledge().setCoalesce(app.oclingo.online.coalesce);
+	output->getExternalKnowledge().setSessions(app.oclingo.online.sessions);
+	if(!app.oclingo.online.statsFile.empty())
+	{
+		output->getExternalKnowledge().stats().file(app.oclingo.online.statsFile, app.oclingo.online.statsInterval);
+	}
 }
 
 
@@ -19,6 +19,13 @@
 #include "externalknowledge.h"
 #include "oclaspoutput.h"
 #include <gringo/grounder.h>
+#include <algorithm>
+
+#ifndef _WIN32
+#	include <sys/types.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
 
 ExternalKnowledge::ExternalKnowledge(Grounder* grounder, oClaspOutput* output, uint32_t port, bool import)
 	: grounder_(grounder)
@@ -26,7 +33,7 @@ ExternalKnowledge::ExternalKnowledge(Grounder* grounder, oClaspOutput* output, u
 	, socket_(NULL)
 	, port_(port)
 	, reading_(false)
-	, new_input_(false)
+	, pending_(false)
 	, my_post_(true)
 	, solver_stopped_(false)
 	, import_(import)
@@ -34,10 +41,10 @@ ExternalKnowledge::ExternalKnowledge(Grounder* grounder, oClaspOutput* output, u
 	, controller_step_(1)
 	, bound_(INT_MAX)
 	, model_(true)
-	, forget_(0)
-	, forget_from_(0)
-	, forget_to_(0)
+	, message_(0)
 	, debug_(false)
+	, coalesce_(false)
+	, sessions_(0)
 {
 	post_ = new ExternalKnowledge::PostPropagator(this);
 
@@ -45,10 +52,13 @@ ExternalKnowledge::ExternalKnowledge(Grounder* grounder, oClaspOutput* output, u
 }
 
 ExternalKnowledge::~ExternalKnowledge() {
-	if(socket_) {
-		socket_->close();
-		delete socket_;
+	if(io_thread_) {
+		// pending messages are written before the socket is closed
+		io_service_.post(boost::bind(&ExternalKnowledge::close, this));
+		work_.reset();
+		io_thread_->join();
 	}
+	delete socket_;
 
 	// only delete post_ if it does not belong to solver
 	if(my_post_) delete post_;
@@ -72,9 +82,55 @@ void ExternalKnowledge::startSocket(int port) {
 	// don't catch exceptions here, exit with error instead
 	tcp::acceptor acceptor(io_service_, tcp::endpoint(tcp::v4(), port));
 	socket_ = new tcp::socket(io_service_);
-	acceptor.accept(*socket_);
+	if(sessions_ > 0) { serve(acceptor); }
+	else { acceptor.accept(*socket_); }
 
 	if(debug_) std::cerr << "Client connected..." << std::endl;
+
+	// from now on the socket is only used by the io thread
+	work_.reset(new boost::asio::io_service::work(io_service_));
+	read();
+	io_thread_.reset(new boost::thread(boost::bind(&ExternalKnowledge::run, this)));
+}
+
+void ExternalKnowledge::serve(boost::asio::ip::tcp::acceptor &acceptor) {
+#ifdef _WIN32
+	(void)acceptor;
+	throw std::runtime_error("Serving several controllers is not supported on this platform.");
+#else
+	std::cerr << "Serving up to " << sessions_ << " controllers on port " << port_ << "..." << std::endl;
+
+	uint32_t running = 0;
+	for(;;) {
+		// reap finished sessions and block while the maximum number is running
+		while(running > 0) {
+			pid_t pid = waitpid(-1, 0, running >= sessions_ ? 0 : WNOHANG);
+			if(pid <= 0) break;
+			running--;
+		}
+		acceptor.accept(*socket_);
+
+		// the base program is already grounded and handed to clasp at this point,
+		// so each session starts on a copy-on-write copy of it
+		io_service_.notify_fork(boost::asio::io_service::fork_prepare);
+		pid_t pid = fork();
+		if(pid == 0) {
+			io_service_.notify_fork(boost::asio::io_service::fork_child);
+			acceptor.close();
+			return;
+		}
+		io_service_.notify_fork(boost::asio::io_service::fork_parent);
+		if(pid < 0) throw std::runtime_error("Could not start a session for the controller.");
+
+		if(debug_) std::cerr << "Started session " << pid << "..." << std::endl;
+		running++;
+		socket_->close();
+	}
+#endif
+}
+
+void ExternalKnowledge::setSessions(uint32_t sessions) {
+	sessions_ = sessions;
 }
 
 void ExternalKnowledge::sendModel(std::string model) {
@@ -93,26 +149,17 @@ bool ExternalKnowledge::hasModel() {
 void ExternalKnowledge::sendToClient(std::string msg) {
 	if(not socket_) startSocket(port_);
 
-	try {
-		boost::asio::write(*socket_, boost::asio::buffer(msg+char(0)), boost::asio::transfer_all());
-	}
-	catch (std::exception& e) {
-		std::cerr << "Warning: Could not send message to controller " << e.what() << std::endl;
-	}
+	io_service_.post(boost::bind(&ExternalKnowledge::write, this, msg));
 }
 
 int ExternalKnowledge::poll() {
-	io_service_.reset();
-	int result = io_service_.poll_one();
-	if(result) {
-		std::cerr << "Polled for input and started " << result << " handler." << std::endl;
-		if(solver_stopped_) {
-			// solver was already stopped, don't try to stop it again
-			result = 0;
-		}
-		solver_stopped_ = true;
-	}
-	return result;
+	// called by the post propagator, so this must not do more than looking at the flag
+	if(solver_stopped_ || !pending_.load(boost::memory_order_acquire)) return 0;
+
+	std::cerr << "Received input while solving." << std::endl;
+	// solver is stopped only once per iteration
+	solver_stopped_ = true;
+	return 1;
 }
 
 void ExternalKnowledge::get() {
@@ -130,7 +177,6 @@ void ExternalKnowledge::get() {
 			sendToClient("Input:\n");
 
 			reading_ = true;
-			boost::asio::async_read_until(*socket_, b_, char(0), boost::bind(&ExternalKnowledge::readUntilHandler, this, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
 		}
 	}
 	catch (std::exception& e) {
@@ -140,17 +186,73 @@ void ExternalKnowledge::get() {
 	solver_stopped_ = false;
 }
 
-void ExternalKnowledge::readUntilHandler(const boost::system::error_code& e, size_t bytesT) {
-	(void)bytesT;
+void ExternalKnowledge::run() {
+	io_service_.run();
+}
+
+void ExternalKnowledge::read() {
+	boost::asio::async_read_until(*socket_, b_, char(0), boost::bind(&ExternalKnowledge::readUntilHandler, this, boost::asio::placeholders::error, boost::asio::placeholders::bytes_transferred));
+}
 
+void ExternalKnowledge::readUntilHandler(const boost::system::error_code& e, size_t bytesT) {
 	if (!e)	{
-		new_input_ = true;
-		reading_ = false;
+		// cut one message (including its terminating zero) from the buffer
+		std::string msg(bytesT, char(0));
+		std::istream is(&b_);
+		is.read(&msg[0], bytesT);
+		StepStats::Time now = StepStats::now();
+		{
+			boost::mutex::scoped_lock lock(input_mutex_);
+			input_.push_back(Input(msg, now));
+			// messages that arrived together are queued together so that they can be coalesced
+			while(std::find(boost::asio::buffers_begin(b_.data()), boost::asio::buffers_end(b_.data()), char(0)) != boost::asio::buffers_end(b_.data())) {
+				std::getline(is, msg, char(0));
+				input_.push_back(Input(msg + char(0), now));
+			}
+			pending_.store(true, boost::memory_order_release);
+		}
+		input_cond_.notify_one();
+		read();
+	}
+	else if(e != boost::asio::error::operation_aborted) {
+		{
+			boost::mutex::scoped_lock lock(input_mutex_);
+			input_error_ = e;
+			pending_.store(true, boost::memory_order_release);
+		}
+		input_cond_.notify_one();
+	}
+}
+
+void ExternalKnowledge::write(std::string msg) {
+	try {
+		boost::asio::write(*socket_, boost::asio::buffer(msg+char(0)), boost::asio::transfer_all());
+	}
+	catch (std::exception& e) {
+		std::cerr << "Warning: Could not send message to controller " << e.what() << std::endl;
 	}
-	else if(e == boost::asio::error::eof)
-		throw std::runtime_error("Connection closed cleanly by client.");
-	else
-		throw boost::system::system_error(e);
+}
+
+void ExternalKnowledge::shutdown() {
+	boost::system::error_code e;
+	socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_send, e);
+}
+
+void ExternalKnowledge::close() {
+	boost::system::error_code e;
+	socket_->close(e);
+}
+
+void ExternalKnowledge::sendStats() {
+	std::stringstream ss;
+	ss << "Stats:\n";
+	stats_.print(ss);
+
+	sendToClient(ss.str());
+}
+
+void ExternalKnowledge::setCoalesce(bool coalesce) {
+	coalesce_ = coalesce;
 }
 
 bool ExternalKnowledge::addInput() {
@@ -158,26 +260,63 @@ bool ExternalKnowledge::addInput() {
 		sendToClient("End of Step.\n");
 	}
 
-	// wait here for input if there is none so far and we have a model or reached bound
-	if(!new_input_ && (model_ || step_ >= bound_)) {
-		io_service_.reset();
-		io_service_.run_one();
+	Input msg;
+	{
+		boost::mutex::scoped_lock lock(input_mutex_);
+		// wait here for input if there is none so far and we have a model or reached bound
+		if(model_ || step_ >= bound_) {
+			while(input_.empty() && !input_error_) { input_cond_.wait(lock); }
+		}
+		if(input_.empty()) {
+			if(input_error_ == boost::asio::error::eof) {
+				throw std::runtime_error("Connection closed cleanly by client.");
+			}
+			else if(input_error_) {
+				throw boost::system::system_error(input_error_);
+			}
+			return true;
+		}
 	}
 
-	//output_->deactivateQueryAtom();
+	output_->deactivateQueryAtom();
+	reading_ = false;
 
-	if(new_input_) {
+	pop(msg);
+	stats_.begin(msg.second);
+	if(!parse(msg.first)) { return false; }
+	// handle input that queued up meanwhile in the same round
+	while(coalesce_ && pop(msg)) {
+		if(debug_) std::cerr << "Coalescing queued input..." << std::endl;
+		// like a new round, a message ends the queries of the previous one
 		output_->deactivateQueryAtom();
-		new_input_ = false;
+		if(!parse(msg.first)) { return false; }
+	}
 
-		std::istream is(&b_);
-		OnlineParser parser(output_, &is);
-		parser.parse();
+	return true;
+}
 
-		if(parser.isTerminated()) {
-			socket_->shutdown(boost::asio::ip::tcp::socket::shutdown_send);
-			return false;
-		}
+bool ExternalKnowledge::pop(Input &msg) {
+	boost::mutex::scoped_lock lock(input_mutex_);
+	if(input_.empty()) { return false; }
+	msg.first.swap(input_.front().first);
+	msg.second = input_.front().second;
+	input_.pop_front();
+	// errors stay pending until addInput rethrows them
+	if(input_.empty() && !input_error_) { pending_.store(false, boost::memory_order_release); }
+	return true;
+}
+
+bool ExternalKnowledge::parse(const std::string &msg) {
+	std::istringstream is(msg);
+	OnlineParser parser(output_, &is);
+	message_++;
+	StepStats::Time start = StepStats::now();
+	parser.parse();
+	stats_.add(StepStats::PARSE, start);
+
+	if(parser.isTerminated()) {
+		io_service_.post(boost::bind(&ExternalKnowledge::shutdown, this));
+		return false;
 	}
 	return true;
 }
@@ -188,7 +327,7 @@ void ExternalKnowledge::addStackPtr(GroundProgramBuilder::StackPtr stack) {
 
 // always call with addStackPtr()
 void ExternalKnowledge::savePrematureVol(OnlineParser::Part part, int window=0) {
-	vol_stack_.push_back(std::make_pair(part, window));
+	vol_stack_.push_back(PrematurePart(part, window, message_, controller_step_));
 }
 
 // always call with addStackPtr()
@@ -197,12 +336,11 @@ void ExternalKnowledge::savePrematureAssertTerm(Val assert_term) {
 }
 
 void ExternalKnowledge::savePrematureForget(int step) {
-	forget_ = step;
+	forget_.push_back(PrematureForget(stacks_.size(), step, step));
 }
 
 void ExternalKnowledge::savePrematureForget(int from, int to) {
-	forget_from_ = from;
-	forget_to_ = to;
+	forget_.push_back(PrematureForget(stacks_.size(), from, to));
 }
 
 bool ExternalKnowledge::addPrematureKnowledge() {
@@ -211,29 +349,43 @@ bool ExternalKnowledge::addPrematureKnowledge() {
 
 	bool added = false;
 	// check for knowledge from previous steps and add it if found
-	if(controller_step_ == step_ && (stacks_.size() > 0 || forget_ || forget_from_)) {
-		std::istream is(&b_);
+	if(controller_step_ == step_ && (stacks_.size() > 0 || !forget_.empty())) {
+		std::istringstream is;
 		OnlineParser parser(output_, &is);
-		while(stacks_.size()) {
-			added = true;
-			// add part information to parser
-			parser.setPart(vol_stack_.front().first);
-			parser.setVolatileWindow(vol_stack_.front().second);
-			parser.setAssertTerm(assert_stack_.front());
+		// forgets are applied in the order they were received (several can be pending if input was coalesced)
+		std::vector<PrematureForget>::iterator forget = forget_.begin();
+		for(size_t pos = 0; stacks_.size(); pos++) {
+			for(; forget != forget_.end() && forget->pos == pos; ++forget) {
+				for(int step = forget->from; step <= forget->to; ++step) { output_->forgetStep(step); }
+			}
+			PrematurePart part = vol_stack_.front();
+			Val assert_term = assert_stack_.front();
+			GroundProgramBuilder::StackPtr stack(stacks_.pop_front().release());
 			vol_stack_.pop_front();
 			assert_stack_.pop_front();
 
-			parser.add(GroundProgramBuilder::StackPtr(stacks_.pop_front().release()));
+			// volatile parts of coalesced messages are superseded by later messages:
+			// queries only hold for the last message and step based windows are
+			// relative to the step they were sent with
+			if(part.part == OnlineParser::VOLATILE) {
+				if(part.window == 0 && part.message != message_) { continue; }
+				part.window -= controller_step_ - part.step;
+				if(part.step < controller_step_ && part.window <= 0) { continue; }
+			}
+
+			added = true;
+			// add part information to parser
+			parser.setPart(part.part);
+			parser.setVolatileWindow(part.window);
+			parser.setAssertTerm(assert_term);
+			parser.add(stack);
 			// return to adding cummulative rules
 			parser.setPart(OnlineParser::CUMULATIVE);
 		}
-
-		if(forget_) { parser.forget(forget_); forget_ = 0; }
-		if(forget_from_) {
-			parser.forget(forget_from_, forget_to_);
-			forget_from_ = 0;
-			forget_to_ = 0;
+		for(; forget != forget_.end(); ++forget) {
+			for(int step = forget->from; step <= forget->to; ++step) { output_->forgetStep(step); }
 		}
+		forget_.clear();
 	}
 
 	return added;
@@ -280,6 +432,23 @@ void ExternalKnowledge::endStep() {
 	std::cerr << "Step: " << step_ << std::endl;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// ExternalKnowledge::PrematurePart / PrematureForget
+//////////////////////////////////////////////////////////////////////////////
+
+ExternalKnowledge::PrematurePart::PrematurePart(OnlineParser::Part part, int window, int message, int step)
+	: part(part)
+	, window(window)
+	, message(message)
+	, step(step)
+{ }
+
+ExternalKnowledge::PrematureForget::PrematureForget(size_t pos, int from, int to)
+	: pos(pos)
+	, from(from)
+	, to(to)
+{ }
+
 //////////////////////////////////////////////////////////////////////////////
 // ExternalKnowledge::PostPropagator
 //////////////////////////////////////////////////////////////////////////////
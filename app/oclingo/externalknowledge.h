@@ -23,6 +23,7 @@
 #include <gringo/lparseconverter.h>
 
 #include <oclingo/onlineparser.h>
+#include <oclingo/stepstats.h>
 
 #include <clasp/solver.h>
 #include <clasp/constraint.h>
@@ -30,6 +31,12 @@
 #include <boost/ptr_container/ptr_list.hpp>
 #include <boost/asio.hpp>
 #include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/atomic.hpp>
+#include <deque>
 
 class oClaspOutput;
 
@@ -47,7 +54,6 @@ public:
 	void sendToClient(std::string msg);
 	int poll();
 	void get();
-	void readUntilHandler(const boost::system::error_code& e, size_t bytesT);
 
 	bool addInput();
 	void addStackPtr(GroundProgramBuilder::StackPtr stack);
@@ -63,6 +69,41 @@ public:
 	bool needsNewStep();
 	void endIteration();
 	void endStep();
+	StepStats &stats() { return stats_; }
+	void sendStats();
+	void setCoalesce(bool coalesce);
+	void setSessions(uint32_t sessions);
+
+private:
+	void serve(boost::asio::ip::tcp::acceptor &acceptor);
+
+	// the following functions are executed by the io thread
+	void run();
+	void read();
+	void readUntilHandler(const boost::system::error_code& e, size_t bytesT);
+	void write(std::string msg);
+	void shutdown();
+	void close();
+
+	typedef std::pair<std::string, StepStats::Time> Input;
+	bool pop(Input &msg);
+	bool parse(const std::string &msg);
+
+	//! part of a premature rule and the message and controller step it was received with
+	struct PrematurePart {
+		PrematurePart(OnlineParser::Part part, int window, int message, int step);
+		OnlineParser::Part part;
+		int window;
+		int message;
+		int step;
+	};
+	//! pending forget; applied after the first pos premature rules
+	struct PrematureForget {
+		PrematureForget(size_t pos, int from, int to);
+		size_t pos;
+		int from;
+		int to;
+	};
 
 protected:
 	struct PostPropagator : public Clasp::PostPropagator {
@@ -80,16 +121,26 @@ private:
 
 	typedef boost::ptr_list<GroundProgramBuilder::Stack> StackPtrList;
 	StackPtrList stacks_;
-	std::list<std::pair<OnlineParser::Part,int> > vol_stack_;
+	std::list<PrematurePart> vol_stack_;
 	std::list<Val> assert_stack_;
 
-	// socket stuff
+	// socket stuff (owned by the io thread once the controller is connected)
 	boost::asio::io_service io_service_;
+	boost::scoped_ptr<boost::asio::io_service::work> work_;
+	boost::scoped_ptr<boost::thread> io_thread_;
 	boost::asio::ip::tcp::socket* socket_;
 	boost::asio::streambuf b_;
 	int port_;
 	bool reading_;
-	bool new_input_;
+
+	// messages received by the io thread with their time of arrival
+	boost::mutex input_mutex_;
+	boost::condition_variable input_cond_;
+	std::deque<Input> input_;
+	boost::system::error_code input_error_;
+	// set by the io thread when a message or an error is queued and cleared by pop once the queue is empty,
+	// the solver only looks at this flag and never takes the mutex
+	boost::atomic<bool> pending_;
 
 	PostPropagator* post_;
 	bool my_post_;
@@ -100,8 +151,11 @@ private:
 	int controller_step_;
 	int bound_;
 	bool model_;
-	int forget_;
-	int forget_from_;
-	int forget_to_;
+	std::vector<PrematureForget> forget_;
+	// number of messages parsed so far
+	int message_;
 	bool debug_;
+	bool coalesce_;
+	uint32_t sessions_;
+	StepStats stats_;
 };
@@ -53,6 +53,7 @@ bool FromGringo<OCLINGO>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int
 			app.setIinit(config);
 			app.groundBase(*grounder, config, app.gringo.iinit, app.clingo.mode == CLINGO ? app.gringo.ifixed : 1, app.clingo.mode == CLINGO ? app.gringo.ifixed : app.clingo.inc.iQuery);
 			out->finalize();
+			grounder->printProfile(app.gringo.statsFile);
 		}
 		else if(app.clingo.mode != OCLINGO)
 		{
@@ -60,6 +61,7 @@ bool FromGringo<OCLINGO>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int
 			config.incStep++;
 			app.groundStep(*grounder, config, config.incStep, app.clingo.inc.iQuery);
 			out->finalize();
+			grounder->printProfile(app.gringo.statsFile);
 		}
 
 		if(app.clingo.mode == OCLINGO)
@@ -92,9 +94,13 @@ bool FromGringo<OCLINGO>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int
 					{
 						out->initialize(); // gives new IncUid for volatiles
 						config.incStep++;
+						StepStats::Time start = StepStats::now();
 						app.groundStep(*grounder, config, config.incStep, app.clingo.inc.iQuery);
+						ext.stats().add(StepStats::GROUND, start);
 						ext.endStep();
+						start = StepStats::now();
 						out->finalize();
+						ext.stats().add(StepStats::FINALIZE, start);
 					}
 					while(config.incStep < ext.getControllerStep());
 
@@ -102,15 +108,20 @@ bool FromGringo<OCLINGO>::read(Clasp::Solver& s, Clasp::ProgramBuilder* api, int
 					if(ext.addPrematureKnowledge())
 					{
 						// call finalize again if there was premature knowledge added
+						StepStats::Time start = StepStats::now();
 						out->finalize();
+						ext.stats().add(StepStats::FINALIZE, start);
 					}
 				}
 				else
 				{
 					// do not increase step, just finish this iteration
 					ext.endIteration();
+					StepStats::Time start = StepStats::now();
 					out->finalize();
+					ext.stats().add(StepStats::FINALIZE, start);
 				}
+				ext.stats().solve();
 			}
 		} // end OCLINGO
 	}
@@ -160,6 +171,14 @@ void ClingoApp<OCLINGO>::doEvent(Clasp::ClaspFacade::Event e, Clasp::ClaspFacade
 				model += it->second.name + " ";
 			}
 		}
-		dynamic_cast<oClaspOutput*>(dynamic_cast<FromGringo<OCLINGO>*>(in_.get())->out.get())->getExternalKnowledge().sendModel(model);
+		ExternalKnowledge& ext = dynamic_cast<oClaspOutput*>(dynamic_cast<FromGringo<OCLINGO>*>(in_.get())->out.get())->getExternalKnowledge();
+		bool first = ext.stats().model();
+		StepStats::Time start = StepStats::now();
+		ext.sendModel(model);
+		if(first)
+		{
+			ext.stats().add(StepStats::SEND, start);
+			ext.stats().end();
+		}
 	}
 }
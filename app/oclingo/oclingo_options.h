@@ -35,6 +35,9 @@ struct oClingoConfig : public Clasp::IncrementalControl
 		, stopUnsat(false)
 		, keepLearnt(true)
 		, keepHeuristic(false)
+		, statsInterval(1)
+		, coalesce(false)
+		, sessions(0)
 	{ }
 	void initStep(Clasp::ClaspFacade& f);
 	bool nextStep(Clasp::ClaspFacade& f);
@@ -47,6 +50,10 @@ struct oClingoConfig : public Clasp::IncrementalControl
 	bool   stopUnsat;     /**< Stop on first unsat problem? */
 	bool   keepLearnt;    /**< Keep learnt nogoods between incremental steps? */
 	bool   keepHeuristic; /**< Keep heuristic values between incremental steps? */
+	std::string statsFile; /**< File latency statistics of the steps are written to */
+	uint32 statsInterval;  /**< Write statistics after every statsInterval steps */
+	bool   coalesce;      /**< Handle all queued input before solving? */
+	uint32 sessions;      /**< Serve up to this many controllers concurrently (0 for a single one) */
 
 };
 
@@ -82,7 +89,13 @@ void oClingoOptions<M>::initOptions(ProgramOptions::OptionGroup& root, ProgramOp
 					"      Default: ext\n"
 					"      Valid:   ext, all\n"
 					"        ext   : Import only heads that have been defined as external\n"
-					"        all   : Import all head atoms");
+					"        all   : Import all head atoms")
+				("step-stats", storeTo(online.statsFile), "Write latency statistics of each step's phases to <file>\n", "<file>")
+				("step-stats-interval", storeTo(online.statsInterval), "Write --step-stats after every <num> steps\n", "<num>")
+				("coalesce", bool_switch(&online.coalesce), "Ground all queued controller input at once and solve only the latest step")
+				("sessions", storeTo(online.sessions),
+					"Serve up to <num> controllers concurrently\n"
+					"      Each session continues from a copy of the grounded base program", "<num>");
 		root.addOptions(online_opts);
 
 		OptionGroup basic("Basic Options");
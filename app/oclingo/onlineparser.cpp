@@ -193,6 +193,10 @@ void OnlineParser::terminate() {
 	terminated_ = true;
 }
 
+void OnlineParser::stats() {
+	output_->getExternalKnowledge().sendStats();
+}
+
 void OnlineParser::setPart(Part part) {
 	part_ = part;
 }
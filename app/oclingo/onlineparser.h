@@ -63,6 +63,7 @@ public:
 	void forget(int step);
 	void forget(int from, int to);
 	void terminate();
+	void stats();
 	void setPart(Part part);
 	void setVolatileWindow(int window);
 	void setAssert();
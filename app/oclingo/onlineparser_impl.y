@@ -54,6 +54,7 @@ line ::= ASSERT  COLON term.         { onlineParser->setAssert(); }
 line ::= RETRACT COLON term.         { onlineParser->retract(); }
 line ::= ENDSTEP.
 line ::= STOP.                       { onlineParser->terminate(); }
+line ::= STATS.                      { onlineParser->stats(); }
 
 step ::= STEP NUMBER(num).                    { onlineParser->setStep(num.number); }
 step ::= STEP NUMBER(num) COLON NUMBER(num2). { onlineParser->setStep(num.number, num2.number); }
@@ -0,0 +1,146 @@
+// Copyright (c) 2012, Torsten Grote <tgrote@uni-potsdam.de>
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stepstats.h"
+#include <iomanip>
+
+namespace
+{
+	const char *phaseNames[] = { "receive", "parse", "ground", "finalize", "solve", "send", "total" };
+}
+
+//////////////////////////////// StepStats::Histogram ////////////////////////////////
+
+StepStats::Histogram::Histogram()
+	: count_(0)
+	, max_(0)
+{
+	std::fill(buckets_, buckets_ + BUCKETS, 0);
+}
+
+void StepStats::Histogram::add(uint64_t us)
+{
+	// bucket i holds values in [2^(i-1), 2^i)
+	uint32_t i = 0;
+	for(uint64_t x = us; x > 0 && i + 1 < BUCKETS; x >>= 1) { i++; }
+	buckets_[i]++;
+	count_++;
+	max_ = std::max(max_, us);
+}
+
+uint64_t StepStats::Histogram::percentile(double p) const
+{
+	if(count_ == 0) { return 0; }
+	uint64_t rank = static_cast<uint64_t>(p * count_ + 0.5);
+	if(rank == 0) { rank = 1; }
+	uint64_t sum = 0;
+	for(uint32_t i = 0; i < BUCKETS; i++)
+	{
+		sum += buckets_[i];
+		// report the upper bound of the bucket but never more than the maximum
+		if(sum >= rank) { return std::min<uint64_t>(max_, (uint64_t(1) << i) - 1); }
+	}
+	return max_;
+}
+
+//////////////////////////////// StepStats ////////////////////////////////
+
+StepStats::StepStats()
+	: active_(false)
+	, waiting_(false)
+	, model_(false)
+	, steps_(0)
+	, interval_(1)
+{
+	std::fill(current_, current_ + PHASES, 0);
+}
+
+StepStats::Time StepStats::now()
+{
+	return boost::posix_time::microsec_clock::universal_time();
+}
+
+void StepStats::file(const std::string &file, uint32_t interval)
+{
+	file_     = file;
+	interval_ = std::max<uint32_t>(1, interval);
+}
+
+void StepStats::begin(const Time &arrival)
+{
+	// steps without a model are only recorded up to the solver
+	if(active_) { end(); }
+	active_  = true;
+	arrival_ = arrival;
+	add(RECEIVE, arrival);
+}
+
+void StepStats::add(Phase phase, const Time &start)
+{
+	if(active_) { current_[phase] += (now() - start).total_microseconds(); }
+}
+
+void StepStats::solve()
+{
+	if(active_)
+	{
+		solve_   = now();
+		waiting_ = true;
+	}
+}
+
+bool StepStats::model()
+{
+	if(!waiting_) { return false; }
+	add(SOLVE, solve_);
+	waiting_ = false;
+	model_   = true;
+	return true;
+}
+
+void StepStats::end()
+{
+	if(!active_) { return; }
+	if(model_) { add(TOTAL, arrival_); }
+	for(uint32_t i = 0; i < PHASES; i++)
+	{
+		// solving is only measured for steps with a model
+		if(model_ || (i != SOLVE && i != SEND && i != TOTAL)) { hist_[i].add(current_[i]); }
+		current_[i] = 0;
+	}
+	active_  = false;
+	waiting_ = false;
+	model_   = false;
+	if(!file_.empty() && ++steps_ % interval_ == 0)
+	{
+		std::ofstream out(file_.c_str());
+		print(out);
+	}
+}
+
+void StepStats::print(std::ostream &out) const
+{
+	out << "phase,count,p50_ms,p99_ms,max_ms\n";
+	out << std::fixed << std::setprecision(3);
+	for(uint32_t i = 0; i < PHASES; i++)
+	{
+		const Histogram &h = hist_[i];
+		out << phaseNames[i] << "," << h.count() << "," << h.percentile(0.5) / 1000.0 << "," << h.percentile(0.99) / 1000.0 << "," << h.max() / 1000.0 << "\n";
+	}
+	out.flush();
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2012, Torsten Grote <tgrote@uni-potsdam.de>
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <gringo/gringo.h>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+//! collects the latency of the phases of oclingo's steps
+class StepStats
+{
+public:
+	enum Phase { RECEIVE, PARSE, GROUND, FINALIZE, SOLVE, SEND, TOTAL, PHASES };
+	typedef boost::posix_time::ptime Time;
+
+private:
+	//! histogram over power of two buckets of microseconds
+	class Histogram
+	{
+	public:
+		enum { BUCKETS = 40 };
+		Histogram();
+		void add(uint64_t us);
+		uint64_t percentile(double p) const;
+		uint64_t count() const { return count_; }
+		uint64_t max() const { return max_; }
+	private:
+		uint64_t buckets_[BUCKETS];
+		uint64_t count_;
+		uint64_t max_;
+	};
+
+public:
+	StepStats();
+	static Time now();
+
+	//! sets the file statistics are dumped to after every interval steps
+	void file(const std::string &file, uint32_t interval);
+	//! starts a new step for input that arrived at the given time
+	void begin(const Time &arrival);
+	//! adds the time passed since start to the phase of the current step
+	void add(Phase phase, const Time &start);
+	//! marks the point where the solver starts working on the current step
+	void solve();
+	//! records the time to the first model of the current step (returns false for later models)
+	bool model();
+	//! adds the phases of the current step to the histograms
+	void end();
+	void print(std::ostream &out) const;
+
+private:
+	Histogram hist_[PHASES];
+	uint64_t  current_[PHASES];
+	Time      arrival_;
+	Time      solve_;
+	bool      active_;
+	bool      waiting_;
+	bool      model_;
+	uint32_t  steps_;
+	std::string file_;
+	uint32_t  interval_;
+};
@@ -0,0 +1,165 @@
+#include <boost/test/unit_test.hpp>
+
+#include <gringo/grounder.h>
+#include <gringo/streams.h>
+#include "clingcon/cspoutput.h"
+#include <clingcon/cspparser.h>
+#include <clingcon/gecodesolver.h>
+#include <clingcon/propagator.h>
+#include <clingcon/exception.h>
+#include <clasp/unfounded_check.h>
+#include <clasp/solve_algorithms.h>
+#include <clasp/model_enumerators.h>
+
+#include <cstdarg>
+
+struct CSPTester : public Clasp::Enumerator::Report
+{
+	CSPTester(std::string const &is, const char *x, ...)
+	{
+		solve(is);
+		va_list vl;
+		va_start(vl, x);
+		check(x, vl);
+		va_end(vl);
+	}
+
+	void solve(std::string const &is)
+	{
+		IncConfig ic;
+		Clasp::ProgramBuilder pb;
+		std::vector<int> optValues;
+		Clingcon::GecodeSolver gecode(false, true, 1, "default", "size-min", "min", optValues, false, false, "simple", "simple", 1, 1);
+		CSPOutput o(false, ic, false, &gecode);
+		BodyOrderHeuristicPtr bo(new BasicBodyOrderHeuristic());
+		Grounder g(&o, false, bo);
+		Clasp::Solver s;
+		Module *mb = g.createModule();
+		Module *mc = g.createModule();
+		mc->parent(mb);
+		Module *mv = g.createModule();
+		mv->parent(mc);
+		Streams in;
+		CSPParser p(&g, mb, mc, mv, ic, in, false, false);
+		Streams::StreamPtr sp(new std::stringstream(is));
+		in.appendStream(sp, "<test>");
+		o.setProgramBuilder(&pb);
+		s.strategies().symTab.reset(new Clasp::AtomIndex());
+		pb.startProgram(*s.strategies().symTab, new Clasp::DefaultUnfoundedCheck());
+		o.initialize();
+		p.parse();
+		g.analyze();
+		g.ground(*mb);
+		g.ground(*mc);
+		g.ground(*mv);
+		o.finalize();
+		if (pb.endProgram(s, false))
+		{
+			// see ClingconApp: constraint atoms must survive preprocessing
+			const Clingcon::CSPSolver::ConstraintMap &m = gecode.getConstraints();
+			for(Clingcon::CSPSolver::ConstraintMap::const_iterator i = m.begin(); i != m.end(); ++i)
+				s.setFrozen(pb.getLiteral(i->first.index()).var(), true);
+			const Clingcon::LParseGlobalConstraintPrinter::GCvec &gcs = gecode.getGlobalConstraints();
+			for(Clingcon::LParseGlobalConstraintPrinter::GCvec::const_iterator i = gcs.begin(); i != gcs.end(); ++i)
+				if (i->atom_) { s.setFrozen(pb.getLiteral(i->atom_).var(), true); }
+			gecode.setSolver(&s);
+			s.addPost(new Clingcon::ClingconPropagator(&gecode));
+			gecode.initialize();
+			if (s.endAddConstraints())
+			{
+				Clasp::SolveParams csp;
+				csp.setEnumerator(new Clasp::RecordEnumerator(this));
+				csp.enumerator()->init(s, 0);
+				Clasp::solve(s, csp);
+			}
+		}
+	}
+
+	void check(const char *x, va_list vl)
+	{
+		std::set<Model> modelSet(models.begin(), models.end());
+		while(x)
+		{
+			Model m;
+			while(x)
+			{
+				m.insert(std::string(x));
+				x = va_arg(vl, const char *);
+			}
+			std::stringstream ss;
+			ss << "expected model:";
+			foreach (std::string const &s, m) { ss << " " << s; }
+			BOOST_CHECK_MESSAGE(modelSet.erase(m), ss.str());
+			x = va_arg(vl, const char *);
+		}
+		foreach (Model const &m, modelSet)
+		{
+			std::stringstream ss;
+			ss << "unexpected model:";
+			foreach (std::string const &s, m) { ss << " " << s; }
+			BOOST_CHECK_MESSAGE(false, ss.str());
+		}
+	}
+
+	void reportModel(const Clasp::Solver& s, const Clasp::Enumerator&)
+	{
+		models.push_back(Model());
+		for (Clasp::AtomIndex::const_iterator it = s.strategies().symTab->begin(); it != s.strategies().symTab->end(); it++)
+		{
+			// skip the atoms of constraints
+			if (!it->second.name.empty() && it->second.name.find('$') == std::string::npos && s.isTrue(it->second.lit))
+			{
+				models.back().insert(it->second.name);
+			}
+		}
+	}
+
+	typedef std::set<std::string> Model;
+
+	std::vector<Model> models;
+};
+
+BOOST_AUTO_TEST_CASE( csp_reified_distinct_test )
+{
+	CSPTester
+	(
+		"$domain(1..3).\n"
+		"r. {p}. {q}.\n"
+		"x $== y.\n"
+		"$distinct{x,y} :- p.\n"
+		"$distinct{x,z} :- q.\n",
+
+		"r", NULL,
+		"q", "r", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( csp_reified_element_test )
+{
+	CSPTester
+	(
+		"$domain(0..3).\n"
+		"r. {p}. {q}.\n"
+		"x $== 1. y $== 2. i $== 0.\n"
+		"$element[x@0,y@1][i] $== 2 :- p.\n"
+		"$element[x@0,y@1][i] $== 1 :- q.\n",
+
+		"r", NULL,
+		"q", "r", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( csp_conditional_cumulative_test )
+{
+	BOOST_CHECK_THROW(CSPTester
+	(
+		"$domain(0..3).\n"
+		"{p}.\n"
+		"$cumulative[s@1,t@1][1@1,1@1][1@1,1@1] $<= 1 :- p.\n",
+
+		NULL,
+		NULL
+	), Clingcon::CSPException);
+}
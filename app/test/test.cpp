@@ -10,19 +10,68 @@
 #include <clasp/solve_algorithms.h>
 #include <clasp/model_enumerators.h>
 #include <gringo/plainoutput.h>
+#include <gringo/reifiedoutput.h>
+#include <gringo/writer.h>
+#include <gringo/snapshot.h>
+#include <gringo/domain.h>
+#ifdef WITH_SQLITE3
+#	include <sqlite3.h>
+#	include <cstdio>
+#endif
 
 #include <cstdarg>
 
+//! grounder options of a Tester run that differ from the defaults
+struct TestOptions
+{
+	TestOptions() : costBodyOrder(false), simplifyRules(false) { }
+	TestOptions &cost() { costBodyOrder = true; return *this; }
+	TestOptions &simplify() { simplifyRules = true; return *this; }
+
+	bool costBodyOrder;
+	bool simplifyRules;
+};
+
 struct Tester : public Clasp::Enumerator::Report
 {
 	Tester(std::string const &is, const char *x, ...)
+	{
+		solve(is);
+		va_list vl;
+		va_start(vl, x);
+		check(x, vl);
+		va_end(vl);
+	}
+
+	//! grounds and solves the program with the given options
+	Tester(TestOptions const &opts, std::string const &is, const char *x, ...)
+	{
+		solve(is, opts);
+		va_list vl;
+		va_start(vl, x);
+		check(x, vl);
+		va_end(vl);
+	}
+
+	//! grounds the incremental program step by step, the volatile part in every step, and solves the last step
+	Tester(int steps, std::string const &is, const char *x, ...)
+	{
+		solveIncremental(is, steps);
+		va_list vl;
+		va_start(vl, x);
+		check(x, vl);
+		va_end(vl);
+	}
+
+	void solve(std::string const &is, TestOptions const &opts = TestOptions())
 	{
 		// ground/solve
 		{
 			IncConfig ic;
 			Clasp::ProgramBuilder pb;
 			ClaspOutput o(true, ic, false);
-			BodyOrderHeuristicPtr bo(new BasicBodyOrderHeuristic());
+			o.simplify(opts.simplifyRules);
+			BodyOrderHeuristicPtr bo(opts.costBodyOrder ? static_cast<BodyOrderHeuristic*>(new CostBodyOrderHeuristic()) : new BasicBodyOrderHeuristic());
 			Grounder g(&o, false, bo);
 			Clasp::Solver s;
 			Module *mb = g.createModule();
@@ -51,33 +100,78 @@ struct Tester : public Clasp::Enumerator::Report
 				Clasp::solve(s, csp);
 			}
 		}
-		// check
+	}
+
+	void solveIncremental(std::string const &is, int steps)
+	{
+		IncConfig ic;
+		Clasp::ProgramBuilder pb;
+		ClaspOutput o(true, ic, true);
+		BodyOrderHeuristicPtr bo(new BasicBodyOrderHeuristic());
+		Grounder g(&o, false, bo);
+		Clasp::Solver s;
+		Module *mb = g.createModule();
+		Module *mc = g.createModule();
+		mc->parent(mb);
+		Module *mv = g.createModule();
+		mv->parent(mc);
+		Streams in;
+		Parser p(&g, mb, mc, mv, ic, in, false, false);
+		Streams::StreamPtr sp(new std::stringstream(is));
+		in.appendStream(sp, "<test>");
+		o.setProgramBuilder(&pb);
+		pb.startProgram(ai, new Clasp::DefaultUnfoundedCheck());
+		for(int step = 1; step <= steps; step++)
 		{
-			va_list vl;
-			va_start(vl, x);
-			std::set<Model> modelSet(models.begin(), models.end());
-			while(x)
+			if(step > 1) { o.setProgramBuilder(&pb.updateProgram()); }
+			o.initialize();
+			if(step == 1)
 			{
-				Model m;
-				while(x)
-				{
-					m.insert(std::string(x));
-					x = va_arg(vl, const char *);
-				}
-				std::stringstream ss;
-				ss << "expected model:";
-				foreach (std::string const &s, m) { ss << " " << s; }
-				BOOST_CHECK_MESSAGE(modelSet.erase(m), ss.str());
-				x = va_arg(vl, const char *);
+				p.parse();
+				g.analyze();
+				g.ground(*mb);
 			}
-			foreach (Model const &m, modelSet)
+			ic.incStep = step;
+			g.ground(*mc);
+			g.groundForget(step);
+			// like GringoApp::groundStep with the query in the first step
+			if(ic.maxVolStep == 1) { g.mark(*mv); }
+			g.ground(*mv);
+			if(ic.maxVolStep == 1) { g.rollback(*mv); }
+			o.finalize();
+			if(!pb.endProgram(s, true)) { return; }
+		}
+		Clasp::LitVec assumptions;
+		pb.getAssumptions(assumptions);
+		Clasp::SolveParams csp;
+		csp.setEnumerator(new Clasp::RecordEnumerator(this));
+		csp.enumerator()->init(s, 0);
+		Clasp::solve(s, assumptions, csp);
+	}
+
+	void check(const char *x, va_list vl)
+	{
+		std::set<Model> modelSet(models.begin(), models.end());
+		while(x)
+		{
+			Model m;
+			while(x)
 			{
-				std::stringstream ss;
-				ss << "unexpected model:";
-				foreach (std::string const &s, m) { ss << " " << s; }
-				BOOST_CHECK_MESSAGE(false, ss.str());
+				m.insert(std::string(x));
+				x = va_arg(vl, const char *);
 			}
-			va_end(vl);
+			std::stringstream ss;
+			ss << "expected model:";
+			foreach (std::string const &s, m) { ss << " " << s; }
+			BOOST_CHECK_MESSAGE(modelSet.erase(m), ss.str());
+			x = va_arg(vl, const char *);
+		}
+		foreach (Model const &m, modelSet)
+		{
+			std::stringstream ss;
+			ss << "unexpected model:";
+			foreach (std::string const &s, m) { ss << " " << s; }
+			BOOST_CHECK_MESSAGE(false, ss.str());
 		}
 	}
 
@@ -527,3 +621,561 @@ BOOST_AUTO_TEST_CASE( junction_bug_3408575 )
 		NULL
 	);
 }
+
+BOOST_AUTO_TEST_CASE( cyclic_join_test )
+{
+	Tester
+	(
+		"#hide."
+		"#show tri/3."
+		"n(1..3)."
+		"e(1,2). e(2,3). e(3,1). e(3,4). e(4,2). e(4,4)."
+		"tri(X,Y,Z) :- e(X,Y), e(Y,Z), e(Z,X), n(Y).",
+
+		"tri(1,2,3)", "tri(2,3,1)", "tri(3,1,2)", "tri(2,3,4)", "tri(4,2,3)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( cost_body_order_test )
+{
+	// the selective literal s(X) has to come first, the result must not depend on the order
+	std::string prog =
+		"#hide."
+		"#show r/2."
+		"n(1..20)."
+		"e(X,Y) :- n(X), n(Y), X < Y."
+		"s(3). s(17)."
+		"r(X,Z) :- e(X,Y), e(Y,Z), s(X), s(Z).";
+	Tester
+	(
+		TestOptions().cost(), prog,
+
+		"r(3,17)", NULL,
+		NULL
+	);
+	Tester
+	(
+		prog,
+
+		"r(3,17)", NULL,
+		NULL
+	);
+	Tester
+	(
+		TestOptions().cost(),
+		"#hide."
+		"#show tri/3."
+		"n(1..3)."
+		"e(1,2). e(2,3). e(3,1). e(3,4). e(4,2). e(4,4)."
+		"tri(X,Y,Z) :- e(X,Y), e(Y,Z), e(Z,X), n(Y).",
+
+		"tri(1,2,3)", "tri(2,3,1)", "tri(3,1,2)", "tri(2,3,4)", "tri(4,2,3)", NULL,
+		NULL
+	);
+	// recursive predicates keep their place after the non-recursive ones
+	Tester
+	(
+		TestOptions().cost(),
+		"#hide."
+		"#show path/2."
+		"edge(1,2). edge(2,3). edge(3,1). start(1)."
+		"path(X,Y) :- edge(X,Y), start(X)."
+		"path(X,Z) :- path(X,Y), edge(Y,Z).",
+
+		"path(1,1)", "path(1,2)", "path(1,3)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( simplify_test )
+{
+	// simplification must not change the models
+	// duplicate rule instance
+	Tester
+	(
+		TestOptions().simplify(),
+		"r. { b }. a :- b, n(X). n(1;2).",
+
+		"r", "n(1)", "n(2)", NULL,
+		"r", "n(1)", "n(2)", "b", "a", NULL,
+		NULL
+	);
+	// fact in a body
+	Tester
+	(
+		TestOptions().simplify(),
+		"r. f. { b }. a :- f, b.",
+
+		"r", "f", NULL,
+		"r", "f", "b", "a", NULL,
+		NULL
+	);
+	// negated fact in a body
+	Tester
+	(
+		TestOptions().simplify(),
+		"r. f. { b }. a :- not f, b. c :- not f.",
+
+		"r", "f", NULL,
+		"r", "f", "b", NULL,
+		NULL
+	);
+	// fact as the head of a choice rule
+	Tester
+	(
+		TestOptions().simplify(),
+		"r. f. { f; b }. a :- f, b.",
+
+		"r", "f", NULL,
+		"r", "f", "b", "a", NULL,
+		NULL
+	);
+	// #sum with fact elements
+	Tester
+	(
+		TestOptions().simplify(),
+		"r. f. { b }. a :- 2 #sum[ f = 1, b = 1 ]. c :- #sum[ f = 1, b = 1 ] 1.",
+
+		"r", "f", "c", NULL,
+		"r", "f", "b", "a", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( recursive_aggr_test )
+{
+	Tester
+	(
+		"#hide."
+		"#show r/1."
+		"node(1..5)."
+		"edge(1,3). edge(2,3). edge(3,4). edge(1,4). edge(4,5)."
+		"r(1). r(2)."
+		"in(X,Y) :- r(X), edge(X,Y)."
+		"r(Y) :- node(Y), 2 #count{ in(X,Y) }.",
+
+		"r(1)", "r(2)", "r(3)", "r(4)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( incremental_aggr_test )
+{
+	// the aggregate is printed in the first step and extended in the later ones
+	Tester
+	(
+		4,
+		"#cumulative t."
+		"{ q(t) }."
+		"enough(t) :- 3 #count{ q(X) }."
+		"#volatile t."
+		":- not enough(t)."
+		":- q(t).",
+
+		"q(1)", "q(2)", "q(3)", "enough(1)", "enough(2)", "enough(3)", "enough(4)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( incremental_upper_aggr_test )
+{
+	// aggregates with upper bounds are extended too
+	Tester
+	(
+		3,
+		"#cumulative t."
+		"{ q(t) }."
+		"few(t) :- #count{ q(X) } 1."
+		"mid(t) :- 2 #count{ q(X) } 2."
+		"#volatile t."
+		":- not q(t).",
+
+		"q(3)", "few(1)", "few(2)", "few(3)", NULL,
+		"q(1)", "q(3)", "mid(1)", "mid(2)", "mid(3)", NULL,
+		"q(2)", "q(3)", "mid(1)", "mid(2)", "mid(3)", NULL,
+		"q(1)", "q(2)", "q(3)", NULL,
+		NULL
+	);
+	// an exceeded upper bound closes the aggregate
+	Tester
+	(
+		3,
+		"#cumulative t."
+		"q(t)."
+		"few(t) :- #count{ q(X) } 1.",
+
+		"q(1)", "q(2)", "q(3)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( volatile_fact_test )
+{
+	// the volatile fact of a step must not be matched in later steps
+	Tester
+	(
+		3,
+		"#hide."
+		"#show r/0."
+		"#show w/1."
+		"r."
+		"#cumulative t."
+		"w(t) :- v(t-1)."
+		"#volatile t."
+		"v(t).",
+
+		"r", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( volatile_window_test )
+{
+	// with a window of two the atom of a volatile step holds in exactly one more step
+	Tester
+	(
+		3,
+		"#hide."
+		"#show r/0."
+		"#show u/1."
+		"#show y/1."
+		"r."
+		"#cumulative t."
+		"{ z(t) }."
+		":- z(t)."
+		"u(t) :- v(t-1)."
+		"y(t) :- v(t-2)."
+		"#volatile t : 2."
+		"v(t) :- not z(t).",
+
+		"r", "u(3)", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( func_term_test )
+{
+	Tester
+	(
+		"#hide."
+		"#show list/1."
+		"#show wide/1."
+		"n(0..2)."
+		"l(nil,0)."
+		"l(c(N,L),N+1) :- l(L,N), n(N)."
+		"list(L) :- l(L,_)."
+		"wide(f(1,2,3,4,5,6,7,8,9,X)) :- n(X), X > 1.",
+
+		"list(nil)", "list(c(0,nil))", "list(c(1,c(0,nil)))", "list(c(2,c(1,c(0,nil))))", "wide(f(1,2,3,4,5,6,7,8,9,2))", NULL,
+		NULL
+	);
+}
+
+BOOST_AUTO_TEST_CASE( shared_cond_test )
+{
+	Tester
+	(
+		"#hide."
+		"#show r/1."
+		"{ p(1..2) }."
+		"{ q(1..2) }."
+		"r(0)."
+		"r(1) :- 2 #count{ p(X) : q(X) }."
+		"r(2) :- 1 #count{ p(X) : q(X) }.",
+
+		"r(0)", NULL,
+		"r(0)", "r(2)", NULL,
+		"r(0)", "r(1)", "r(2)", NULL,
+		NULL
+	);
+}
+
+namespace
+{
+	//! grounds a program with the given output and returns the grounder
+	Grounder *groundOutput(Output *o, std::string const &is)
+	{
+		IncConfig ic;
+		BodyOrderHeuristicPtr bo(new BasicBodyOrderHeuristic());
+		std::auto_ptr<Grounder> g(new Grounder(o, false, bo));
+		Module *mb = g->createModule();
+		Module *mc = g->createModule();
+		mc->parent(mb);
+		Module *mv = g->createModule();
+		mv->parent(mc);
+		Streams in;
+		Parser p(g.get(), mb, mc, mv, ic, in, false, false);
+		Streams::StreamPtr sp(new std::stringstream(is));
+		in.appendStream(sp, "<test>");
+		o->initialize();
+		p.parse();
+		g->analyze();
+		g->ground(*mb);
+		o->finalize();
+		return g.release();
+	}
+
+	//! grounds a program with plain text output and returns the grounder
+	Grounder *groundPlain(std::ostream &out, std::string const &is, std::auto_ptr<PlainOutput> &o)
+	{
+		o.reset(new PlainOutput(out));
+		return groundOutput(o.get(), is);
+	}
+
+	//! groups the arguments after the first one of the facts of the given predicate by their first argument
+	std::map<std::string, std::vector<std::string> > groupFacts(std::istream &in, std::string const &pred)
+	{
+		std::map<std::string, std::vector<std::string> > groups;
+		std::string line;
+		while(std::getline(in, line))
+		{
+			if(line.compare(0, pred.size() + 1, pred + "(") != 0) { continue; }
+			size_t comma = line.find(',');
+			// strip the closing ")."
+			groups[line.substr(pred.size() + 1, comma - pred.size() - 1)].push_back(line.substr(comma + 1, line.size() - comma - 3));
+		}
+		return groups;
+	}
+}
+
+BOOST_AUTO_TEST_CASE( reified_scc_test )
+{
+	std::stringstream out;
+	{
+		ReifiedOutput o(out);
+		std::auto_ptr<Grounder> g(groundOutput(&o,
+			"{ a; c }."
+			"a :- b. b :- a."
+			"c :- d. d :- c."
+			"x :- a, c. y :- a, c."
+			"z :- 2 [ a = 1, c = 2 ]. w :- 2 [ a = 1, c = 2 ]."));
+	}
+	typedef std::map<std::string, std::vector<std::string> > Groups;
+	// one component for a, b and one for c, d
+	std::stringstream scc(out.str());
+	std::set<std::set<std::string> > comps;
+	foreach(Groups::const_reference group, groupFacts(scc, "scc"))
+	{
+		comps.insert(std::set<std::string>(group.second.begin(), group.second.end()));
+	}
+	std::set<std::set<std::string> > expected;
+	std::set<std::string> comp;
+	comp.insert("pos(atom(a))");
+	comp.insert("pos(atom(b))");
+	expected.insert(comp);
+	comp.clear();
+	comp.insert("pos(atom(c))");
+	comp.insert("pos(atom(d))");
+	expected.insert(comp);
+	BOOST_CHECK(comps == expected);
+	// the bodies of x and y as well as the aggregates of z and w are stored once
+	std::stringstream sets(out.str());
+	std::set<std::vector<std::string> > distinct;
+	Groups setGroups = groupFacts(sets, "set");
+	foreach(Groups::const_reference group, setGroups)
+	{
+		BOOST_CHECK_MESSAGE(distinct.insert(group.second).second, "set " + group.first + " printed twice");
+	}
+	std::vector<std::string> body;
+	body.push_back("pos(atom(a))");
+	body.push_back("pos(atom(c))");
+	BOOST_CHECK(distinct.find(body) != distinct.end());
+	std::stringstream lists(out.str());
+	distinct.clear();
+	Groups listGroups = groupFacts(lists, "wlist");
+	foreach(Groups::const_reference group, listGroups)
+	{
+		BOOST_CHECK_MESSAGE(distinct.insert(group.second).second, "list " + group.first + " printed twice");
+	}
+	BOOST_CHECK_EQUAL(listGroups.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( snapshot_test )
+{
+	std::stringstream state, out;
+	{
+		std::auto_ptr<PlainOutput> o;
+		std::auto_ptr<Grounder> g(groundPlain(out, "p(f(a,1)). p(g(\"s\")). q(X) :- p(X). { r(1..2) }.", o));
+		Snapshot::save(state, g.get(), 0, 3);
+	}
+	{
+		// other strings and function terms are interned first so that indices differ
+		std::auto_ptr<PlainOutput> o;
+		std::auto_ptr<Grounder> g(groundPlain(out, "s(h(b,c)). t(g(x)).", o));
+		BOOST_CHECK_EQUAL(Snapshot::load(state, g.get(), 0), 3);
+		Domain *q = g->newDomain(g->index("q"), 1);
+		Domain *r = g->newDomain(g->index("r"), 1);
+		BOOST_CHECK_EQUAL(q->size(), 2u);
+		BOOST_CHECK_EQUAL(r->size(), 2u);
+		ValVec args;
+		args.push_back(Val::id(g->index("a")));
+		args.push_back(Val::number(1));
+		ValVec atom(1, Val::func(g->index(g->index("f"), args)));
+		BOOST_CHECK(q->find(atom.begin()).fact);
+		atom[0] = Val::func(g->index(g->index("g"), ValVec(1, Val::string(g->index("s")))));
+		BOOST_CHECK(q->find(atom.begin()).fact);
+		atom[0] = Val::number(1);
+		BOOST_CHECK(r->find(atom.begin()).valid());
+		BOOST_CHECK(!r->find(atom.begin()).fact);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( writer_test )
+{
+	std::stringstream out;
+	{
+		Writer w(out);
+		w << std::numeric_limits<int32_t>::min() << " " << int32_t(0) << " " << int32_t(-42) << " " << uint32_t(7) << " ";
+		w << std::numeric_limits<int64_t>::min() << " " << std::numeric_limits<uint64_t>::max() << '.';
+	}
+	BOOST_CHECK_EQUAL(out.str(), "-2147483648 0 -42 7 -9223372036854775808 18446744073709551615.");
+	std::stringstream vals;
+	Val::number(std::numeric_limits<int32_t>::min()).print(0, vals);
+	vals << " ";
+	Val::number(0).print(0, vals);
+	vals << " ";
+	Val::number(-1).print(0, vals);
+	vals << " ";
+	Val::number(std::numeric_limits<int32_t>::max()).print(0, vals);
+	BOOST_CHECK_EQUAL(vals.str(), "-2147483648 0 -1 2147483647");
+}
+
+BOOST_AUTO_TEST_CASE( delayed_output_test )
+{
+	std::stringstream out;
+	{
+		PlainOutput o(out);
+		// a rule whose body waits for two delayed parts, e.g. aggregates with conditions
+		o.out() << "a:-";
+		DelayedOutput::Offset first = o.beginDelay();
+		o.out() << ",";
+		DelayedOutput::Offset second = o.beginDelay();
+		o.out() << ".\n";
+		o.endStatement();
+		// lines without delayed parts are written right away
+		o.out() << "b.\n";
+		o.endStatement();
+		o.out() << "2 #count{p(1),p(2)}";
+		o.contDelay(second);
+		o.endDelay(second);
+		BOOST_CHECK_EQUAL(out.str(), "");
+		o.out() << "q(1)";
+		o.contDelay(first);
+		o.endDelay(first);
+		// the line is reused for the next rule
+		o.out() << "c:-";
+		DelayedOutput::Offset third = o.beginDelay();
+		o.out() << ".\n";
+		o.endStatement();
+		o.out() << "not d";
+		o.contDelay(third);
+		o.endDelay(third);
+	}
+	BOOST_CHECK_EQUAL(out.str(), "b.\na:-q(1),2 #count{p(1),p(2)}.\nc:-not d.\n");
+}
+
+#ifdef WITH_SQLITE3
+BOOST_AUTO_TEST_CASE( sql_test )
+{
+	const char *db = "sql_test.db";
+	std::remove(db);
+	sqlite3 *conn;
+	BOOST_REQUIRE(sqlite3_open(db, &conn) == SQLITE_OK);
+	BOOST_REQUIRE(sqlite3_exec(conn,
+		"CREATE TABLE edge(src INTEGER, dst INTEGER, label TEXT);"
+		"INSERT INTO edge VALUES (1, 2, 'a');"
+		"INSERT INTO edge VALUES (2, 3, 'b');"
+		"INSERT INTO edge VALUES (3, 1, NULL);", 0, 0, 0) == SQLITE_OK);
+	sqlite3_close(conn);
+	Tester
+	(
+		"#hide."
+		"#show p/2."
+		"#sql edge/3 : \"sql_test.db\" : \"edge\"."
+		"n(1..3)."
+		"p(X,L) :- n(X), edge(X,Y,L).",
+
+		"p(1,\"a\")", "p(2,\"b\")", NULL,
+		NULL
+	);
+	std::remove(db);
+}
+
+BOOST_AUTO_TEST_CASE( sql_quote_test )
+{
+	const char *db = "sql_quote_test.db";
+	std::remove(db);
+	sqlite3 *conn;
+	BOOST_REQUIRE(sqlite3_open(db, &conn) == SQLITE_OK);
+	BOOST_REQUIRE(sqlite3_exec(conn,
+		"CREATE TABLE \"my table\"(\"from\" INTEGER, \"a\"\"b\" INTEGER);"
+		"INSERT INTO \"my table\" VALUES (1, 2);"
+		"INSERT INTO \"my table\" VALUES (2, 3);", 0, 0, 0) == SQLITE_OK);
+	sqlite3_close(conn);
+	Tester
+	(
+		"#hide."
+		"#show p/1."
+		"#sql e/2 : \"sql_quote_test.db\" : \"my table\"."
+		"p(Y) :- e(2,Y).",
+
+		"p(3)", NULL,
+		NULL
+	);
+	// atoms of the predicate come only from the table
+	BOOST_CHECK_THROW(Tester
+	(
+		"#sql e/2 : \"sql_quote_test.db\" : \"my table\"."
+		"e(3,4).",
+
+		NULL
+	), std::exception);
+	std::remove(db);
+}
+
+#ifdef WITH_LUASQL
+BOOST_AUTO_TEST_CASE( luasql_stmt_test )
+{
+	Tester
+	(
+		"#begin_lua\n"
+		"local con = assert(luasql.sqlite3():connect(\":memory:\"))\n"
+		"assert(con:execute(\"CREATE TABLE t(a INTEGER, b TEXT)\"))\n"
+		"for i = 1, 3 do assert(con:execute(\"INSERT INTO t VALUES (\" .. i .. \", 'x\" .. i .. \"')\")) end\n"
+		"local stmt = assert(con:prepare(\"SELECT b FROM t WHERE a >= ? ORDER BY a\"))\n"
+		// a cursor dropped after one row must not block the statement
+		"local cur = assert(stmt:execute(1))\n"
+		"assert(cur:fetch() == \"x1\")\n"
+		"cur = assert(stmt:execute(2))\n"
+		"assert(cur:fetch() == \"x2\" and cur:fetch() == \"x3\" and cur:fetch() == nil)\n"
+		// executing again detaches the previous cursor
+		"local old = assert(stmt:execute(1))\n"
+		"assert(old:fetch() == \"x1\")\n"
+		"cur = assert(stmt:execute(3))\n"
+		"assert(old:fetch() == nil and cur:fetch() == \"x3\")\n"
+		"old:close()\n"
+		"cur:close()\n"
+		// the row stepped to by execute is returned exactly once
+		"local rows = assert(stmt:execute(1)):fetchmany(10)\n"
+		"assert(#rows == 3 and rows[1][1] == \"x1\" and rows[3][1] == \"x3\")\n"
+		"cur = assert(con:execute(\"SELECT b FROM t ORDER BY a\"))\n"
+		"assert(cur:fetch() == \"x1\" and cur:fetch() == \"x2\")\n"
+		"cur:close()\n"
+		// column information of a cursor outlives its statement
+		"cur = assert(stmt:execute(1))\n"
+		"assert(stmt:close())\n"
+		"assert(cur:getcolnames()[1] == \"b\" and cur:fetch() == nil)\n"
+		"cur:close()\n"
+		"collectgarbage()\n"
+		"assert(con:close())\n"
+		"function checked() return 1 end\n"
+		"#end_lua.\n"
+		"p(@checked()).",
+
+		"p(1)", NULL,
+		NULL
+	);
+}
+#endif
+#endif
@@ -31,12 +31,14 @@ parser.add_option("-n", "--host", dest="host", help="Hostname of the online iCli
 parser.add_option("-p", "--port", dest="port", help="Port the online iClingo server is listening to. Default: %default")
 parser.add_option("-t", "--time", dest="time", help="Time delay in seconds between sending input from online.lp to server. Default: %default")
 parser.add_option("-w", "--wait", dest="wait", choices=["yes","no"], help="Wait for answer set before sending new input, yes or no. Default: %default")
+parser.add_option("-b", "--batch", dest="batch", help="Number of steps from online.lp sent at once when waiting for answer sets. Default: %default")
 parser.add_option("-d", "--debug", dest="debug", help="show debugging output", action="store_true")
 parser.set_defaults(
 	host = 'localhost',
 	port = 25277,
 	time = 0,
 	wait = "yes",
+	batch = 1,
 	debug = False
 )
 (opt, args) = parser.parse_args()
@@ -93,6 +95,11 @@ def main():
 			
 			if opt.wait == "yes":
 				input = getInput()
+				# further steps are sent in the same write, '#stop.' is always sent alone
+				for n in range(1, int(opt.batch)):
+					if len(args) != 1 or len(online_input) == 0:
+						break
+					input += '\0' + getInput()
 				sendInput(s, input)
 			else:
 				# just in case, should be done before thread terminates
@@ -38,6 +38,7 @@ TESTS = [
 	['technical1', 'technical.lp', 'online7.lp', 'online7.out'],
 	['technical2', 'volatile1.lp', 'vonline1.lp', 'vonline1.out'],
 	['technical2',  'vquery.lp', 'vquery.str', 'vquery.out'], # Volatile query effective life-time test
+	['technical2',  'coalesce.lp', 'coalesce.str', 'coalesce.out', {'oclingo': ['--coalesce'], 'controller': ['-b 2']}], # Steps sent back-to-back
 	['tictactoe', 'tictactoe.lp', 'online.lp',   'online.out'],
 	['tictactoe', 'tictactoe.lp', 'online2.lp', 'online2.out'],
 	['tictactoe', 'tictactoe.lp', 'online3.lp', 'online3.out'],
@@ -84,6 +85,11 @@ def main():
 
 class TestCase:
 	def __init__(self, case):
+		# optional extra arguments for oclingo and the controller
+		self.options = {}
+		if isinstance(case[-1], dict):
+			self.options = case[-1]
+			case = case[:-1]
 		self.name = case[0]
 		self.encoding = os.path.join(self.name, case[1])
 		if len(case) > 4:
@@ -138,7 +144,7 @@ def findPrograms():
 def runOClingo(test):
 	global OCLINGO
 	try:
-		subprocess.Popen([OCLINGO, test.instance, test.encoding, '--imax=99', '0'], stdout=subprocess.PIPE, stderr=subprocess.PIPE).pid
+		subprocess.Popen([OCLINGO, test.instance, test.encoding, '--imax=99', '0'] + test.options.get('oclingo', []), stdout=subprocess.PIPE, stderr=subprocess.PIPE).pid
 	except OSError, err:
 		print err
 		sys.exit(1)
@@ -153,7 +159,7 @@ def runController(test):
 			if tmp == 0:
 				break;
 		
-		(result, error) = subprocess.Popen([CONTROLLER, '-t 0', test.online], stdout=subprocess.PIPE, stderr=subprocess.PIPE).communicate()
+		(result, error) = subprocess.Popen([CONTROLLER, '-t 0'] + test.options.get('controller', []) + [test.online], stdout=subprocess.PIPE, stderr=subprocess.PIPE).communicate()
 
 		return result
 	except OSError, err:
@@ -9,6 +9,8 @@
 #include <gringo/grounder.h>
 #include <clingcon/exception.h>
 #include <gringo/lparseconverter.h>
+#include <src/output/lparserule_impl.h>
+#include <clingcon/cspoutputinterface.h>
 
 
  namespace Clingcon
@@ -40,6 +42,10 @@
                 case MAXIMIZE_SET:
                 case MAXIMIZE: output_->out() << "$maximize";
                 break;
+                case CUMULATIVE: output_->out() << "$cumulative";
+                break;
+                case ELEMENT: output_->out() << "$element";
+                break;
                 default: assert(false);
                 }
                 output_->print();
@@ -58,7 +64,7 @@
                     return;
                 }
 
-                if ((type_==COUNT || type_==COUNT_UNIQUE) && numHead_==1)
+                if (isCmpHead(type_, numHead_))
                     assert(false);
                 else
                     if (type_==COUNT_GLOBAL && numHead_==0)
@@ -97,7 +103,7 @@
                             vec[i].vweight_.print(output_->storage(), output_->out());
 
                     }else
-                    if (type_==COUNT && numHead_==1)
+                    if (isCmpHead(type_, numHead_))
                     {
                         continue;
                     }else
@@ -154,7 +160,7 @@
                     return;
                 }
 
-                if ((type_==COUNT || type_==COUNT_UNIQUE)&& numHead_==1)
+                if (isCmpHead(type_, numHead_))
                     ;
                 else
                     output_->out() << "]";
@@ -162,6 +168,11 @@
                 numHead_++;
             }
 
+            void beginBody()
+            {
+                output_->endHead();
+            }
+
             void end()
             {
                 output_->endRule();
@@ -187,14 +198,28 @@
     public:
             struct GC
             {
+                GC() : atom_(0) { }
+
+                // variables of all heads, see GroundConstraint::getAllVariables
+                void getAllVariables(std::vector<unsigned int>& vec, CSPSolver* csps) const
+                {
+                    for (boost::ptr_vector<IndexedGroundConstraintVec>::const_iterator i = heads_.begin(); i != heads_.end(); ++i)
+                        for (IndexedGroundConstraintVec::const_iterator j = i->begin(); j != i->end(); ++j)
+                        {
+                            j->a_->getAllVariables(vec, csps);
+                            j->b_.getAllVariables(vec, csps);
+                        }
+                }
+
                 GCType type_;
                 boost::ptr_vector<IndexedGroundConstraintVec> heads_;
                 CSPLit::Type cmp_;
+                uint32_t atom_; // the constraint is reified on this atom, 0 if it holds unconditionally
             };
 
             typedef boost::ptr_vector<GC> GCvec;
 
-            LParseGlobalConstraintPrinter(LparseConverter *output) : output_(output), numHead_(0) { }
+            LParseGlobalConstraintPrinter(LparseConverter *output) : output_(output), numHead_(0), reified_(false) { }
 
             void type(GCType type)
             {
@@ -216,6 +241,10 @@
                 case MAXIMIZE_SET:
                 case MAXIMIZE: out_ << "$maximize";
                 break;
+                case CUMULATIVE: out_ << "$cumulative";
+                break;
+                case ELEMENT: out_ << "$element";
+                break;
                 default: assert(false);
                 }
             }
@@ -234,7 +263,7 @@
                     return;
                 }
 
-                if ((tempGC_->type_==COUNT || tempGC_->type_==COUNT_UNIQUE) && numHead_==1)
+                if (isCmpHead(tempGC_->type_, numHead_))
                     assert(false);
                 else
                     if (tempGC_->type_==COUNT_GLOBAL && numHead_==0)
@@ -274,7 +303,7 @@
                             vec[i].vweight_.print(output_->storage(), out_);
 
                     }else
-                    if (tempGC_->type_==COUNT && numHead_==1)
+                    if (isCmpHead(tempGC_->type_, numHead_))
                     {
                         continue;
                     }else
@@ -338,7 +367,7 @@
                     return;
                 }
 
-                if ((tempGC_->type_==COUNT || tempGC_->type_==COUNT_UNIQUE)&& numHead_==1)
+                if (isCmpHead(tempGC_->type_, numHead_))
                     ;
                 else
                     out_ << "]";
@@ -347,6 +376,15 @@
 
             }
 
+            void beginBody()
+            {
+                // prints :- body, not c. where the constraint c is reified on a fresh atom
+                reified_ = true;
+                Rule::Printer *printer = output_->printer<Rule::Printer>();
+                printer->begin();
+                printer->endHead();
+            }
+
             void end()
             {
                 if (tempGC_->type_==BINPACK)
@@ -355,7 +393,7 @@
                         throw CSPException("In the binpack constraint, the number of items and sizes must be equal.");
                     for (size_t i = 0; i < tempGC_->heads_[0].size(); ++i)
                     {
-                        if (!tempGC_->heads_[0][i].b_.isInteger() || tempGC_->heads_[0][i].b_.getInteger()!=i)
+                        if (!tempGC_->heads_[0][i].b_.isInteger() || tempGC_->heads_[0][i].b_.getInteger()!=static_cast<int>(i))
                         {
                             throw CSPException("In the binpack constraint, the indices of the bins must be consecutive integers, starting with 0.");
                         }
@@ -369,8 +407,38 @@
                         }
                     }
                 }
+                if (tempGC_->type_==CUMULATIVE)
+                {
+                    if (tempGC_->heads_[0].size() != tempGC_->heads_[1].size() || tempGC_->heads_[0].size() != tempGC_->heads_[2].size())
+                        throw CSPException("In the cumulative constraint, the number of start times, durations and resource usages must be equal.");
+                    for (size_t i = 0; i < tempGC_->heads_[0].size(); ++i)
+                    {
+                        if ((tempGC_->heads_[0][i].b_) != (tempGC_->heads_[1][i].b_) || (tempGC_->heads_[0][i].b_) != (tempGC_->heads_[2][i].b_))
+                        {
+                            throw CSPException("Index Mismatch in the cumulative constraint. Start times, durations and resource usages must have the same indices.");
+                        }
+                    }
+                }
+                if (tempGC_->type_==ELEMENT)
+                {
+                    for (size_t i = 0; i < tempGC_->heads_[0].size(); ++i)
+                    {
+                        if (!tempGC_->heads_[0][i].b_.isInteger() || tempGC_->heads_[0][i].b_.getInteger()!=static_cast<int>(i))
+                        {
+                            throw CSPException("In the element constraint, the indices of the array must be consecutive integers, starting with 0.");
+                        }
+                    }
+                }
                 constraints_.push_back(tempGC_);
-                 //uint32_t atom = static_cast<CSPOutputInterface*>(output_)->symbol(name,true);
+                if (reified_)
+                {
+                    lparseconverter_impl::RulePrinter *printer = static_cast<lparseconverter_impl::RulePrinter*>(output_->printer<Rule::Printer>());
+                    tempGC_->atom_ = static_cast<CSPOutputInterface*>(output_)->symbol(out_.str(), true);
+                    printer->addBody(tempGC_->atom_, true);
+                    printer->end();
+                    reified_ = false;
+                }
+                else
                  output_->printBasicRule(static_cast<CSPOutputInterface*>(output_)->symbol(out_.str(), false), LparseConverter::AtomVec(), LparseConverter::AtomVec());
                 // output_->printBasicRule(static_cast<CSPOutputInterface*>(output_)->symbol("test", true), LparseConverter::AtomVec(), LparseConverter::AtomVec());
                  numHead_=0;
@@ -400,6 +468,7 @@
             GCvec constraints_;
             std::stringstream out_;
             size_t numHead_;
+            bool reified_;
     };
 
 
@@ -263,8 +263,9 @@ namespace Clingcon
                     boost::unordered_map<std::string,unsigned int>::iterator i = map_.find(name_[0]);
                     if (i!=map_.end())
                     {
+                        // the solver already got this constraint
                         printer->addBody(i->second, false);
-                        constraints_.push_back(std::make_pair(i->second,stack_[0]));
+                        delete stack_[0];
                     }
                     else
                     {
@@ -283,6 +284,21 @@ namespace Clingcon
                 return &constraints_;
             }
 
+            // retired constraints get a fresh atom if they are used again
+            void forget(const LparseConverter::AtomVec& atoms)
+            {
+                if (atoms.empty())
+                    return;
+                boost::unordered_set<uint32_t> retired(atoms.begin(), atoms.end());
+                for (boost::unordered_map<std::string,unsigned int>::iterator i = map_.begin(); i != map_.end(); )
+                {
+                    if (retired.find(i->second) != retired.end())
+                        i = map_.erase(i);
+                    else
+                        ++i;
+                }
+            }
+
             LparseConverter *output() const { return output_; }
         private:
             LparseConverter *output_;
@@ -29,6 +29,7 @@
 namespace Clasp {
 	class ProgramBuilder;
 	class Solver;
+	class Enumerator;
 }
 
 namespace Clingcon {
@@ -78,6 +79,17 @@ private:
                         virtual void addConstraint(Constraint* c, int uid);
                         virtual const ConstraintMap& getConstraints() const;
                         virtual void addGlobalConstraints(LParseGlobalConstraintPrinter::GCvec& gcvec);
+                        virtual const LParseGlobalConstraintPrinter::GCvec& getGlobalConstraints() const;
+                        // the constraint with the given uid only occurred in expired volatile rules
+                        virtual void retireConstraint(int uid);
+                        // the constraint with the given uid is used by volatile rules that hold while the atom stepUid is false,
+                        // stepUid is 0 if it is used by a rule that holds in all later steps
+                        virtual void guardConstraint(int uid, int stepUid);
+                        // the minimize statement with the highest priority, lparse lists it last and clasp puts it first
+                        virtual void setAspMinimize(const LparseConverter::AtomVec &pos, const LparseConverter::AtomVec &neg,
+                                                    const LparseConverter::WeightVec &wPos, const LparseConverter::WeightVec &wNeg);
+                        // the optimum of the enumerator's minimize constraint bounds the asp minimize statement
+                        virtual void setAspEnumerator(const Clasp::Enumerator* en);
                         virtual bool hasOptimizeStm() const;
                         //virtual void addDomain(const std::string& var, int lower, int upper);
                         virtual unsigned int getVariable(const std::string& s);
@@ -94,7 +106,8 @@ private:
                         //propagate after model was found
                         virtual bool propagateMinimize() = 0;
 			virtual void reset() = 0;
-			virtual void propagateLiteral(const Clasp::Literal& l, int date) = 0;
+			// returns false if the literal does not belong to a constraint anymore
+			virtual bool propagateLiteral(const Clasp::Literal& l, int date) = 0;
                         virtual void undo(unsigned int level) = 0;
                         virtual void printStatistics() = 0;
 			/*
@@ -126,6 +139,15 @@ private:
 
                         ConstraintMap constraints_;
                         LParseGlobalConstraintPrinter::GCvec globalConstraints_;
+                        typedef std::map<const LParseGlobalConstraintPrinter::GC*, Clasp::Literal> GlobalLitMap;
+                        GlobalLitMap globalLits_; // literals of the reified global constraints of all steps
+                        std::vector<int> retiredUids_; // uids of constraints retired since the last step
+                        std::vector<std::pair<int,int> > guardUids_; // uids of constraints and their step atoms since the last step
+                        typedef std::vector<std::pair<Clasp::Literal, Clasp::Literal> > GuardVec;
+                        GuardVec guards_; // guarded constraint literals and the step literals they depend on
+                        std::vector<std::pair<int,int> > aspMinimizeUids_; // atoms of the asp minimize statement, negative if negated, and their weights
+                        std::vector<std::pair<Clasp::Literal, int> > aspMinimize_; // the same as weighted literals
+                        const Clasp::Enumerator* aspEnumerator_;
         protected:
 
                         //Domains domains_;
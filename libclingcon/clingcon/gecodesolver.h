@@ -39,6 +39,7 @@ namespace Clingcon {
 
     class ConflictAnalyzer;
     class ReasonAnalyzer;
+    class Waitress;
 
     class GecodeSolver : public CSPSolver
     {
@@ -77,16 +78,20 @@ namespace Clingcon {
         //virtual void setDomain(int lower, int upper);
         //virtual void addConstraint(Constraint c, int uid);
         //virtual void addDomain(const std::string& var, int lower, int upper);
-        virtual void propagateLiteral(const Clasp::Literal& l, int date);
+        virtual bool propagateLiteral(const Clasp::Literal& l, int date);
+        // can be called once per (incremental) step, only new constraints are added to the root space
         virtual bool initialize();
         unsigned int currentDL() const;
         unsigned int assLength(unsigned int index) const;
         typedef Interval<int>    IntInterval;
         typedef IntervalSet<int> Domain;
-        typedef std::map<unsigned int, Domain> DomainMap;
+        typedef std::vector<std::pair<unsigned int, Domain> > DomainMap; // sorted by variable
+        typedef std::vector<Domain> DomainVec;
 
         // is called when lit is derived via propagation (also by setting it manually?)
         void newlyDerived(Clasp::Literal lit);
+        // throw away everything but the root space
+        void resetSearch();
         void addLitToIndex(Clasp::Literal lit, unsigned int index);
 
         // is called to get the current space,
@@ -100,7 +105,34 @@ namespace Clingcon {
         DomainMap guessDomainsImpl(const Constraint* c);
         void guessDomains(const Constraint* c, bool val);
 
-        DomainMap domains_;   // a domain for each variable
+        typedef std::vector<std::pair<const Constraint*, bool> > DecidedVec;
+        // true if the constraint only restricts one variable to a set of integers
+        // if it is decided, it is completely represented by the initial domain
+        bool isDomainConstraint(const Constraint* c, unsigned int& var);
+        // restrict the domains of variables related by decided binary constraints until fixpoint
+        void boundDomains(const DecidedVec& binary);
+        // order constraints by number of variables and group them by the variables they share
+        void orderConstraints(ConstraintMap& constraints, std::vector<ConstraintMap::iterator>& order);
+        // forgets retired constraints, their propagators stay switched off in the root space
+        void retireConstraints();
+        // converts the guards of this step to literals and watches their step literals
+        void initGuards();
+        // true if the new constraint lit only has to hold while some volatile steps are active
+        bool guarded(Clasp::Literal lit) const;
+        // switches off the guards whose step literal became a fact
+        void retireSteps();
+
+        DomainVec domains_;   // a domain for each variable, unrestricted variables have the default domain
+        ConstraintMap oldConstraints_; // constraints of previous steps, already posted to the root space
+        LParseGlobalConstraintPrinter::GCvec oldGlobalConstraints_; // global constraints of previous steps
+        std::vector<bool> retiredVars_; // clasp variables of retired constraints
+        typedef std::map<Clasp::Literal, Clasp::LitVec> GuardMap;
+        GuardMap newGuards_; // step literals of the guards of this step, posLit(0) if the constraint has to hold in all steps
+        std::map<Clasp::Literal, unsigned int> guardIndex_; // guarded constraint literal -> its variable in SearchSpace::r_
+        Clasp::LitVec stepLits_; // step literals that are not yet facts
+        // true if clasp found a model with a better optimum
+        bool updateAspBound();
+        int aspBound_; // the optimum of the asp minimize statement, Int::Limits::max if there is none yet
     public:
         // return pointer to space on level 0
         SearchSpace* getRootSpace() const;
@@ -270,6 +302,9 @@ namespace Clingcon {
             SearchSpace(bool share, SearchSpace& sp);
             virtual ~SearchSpace(){}
             virtual SearchSpace* copy(bool share);
+            // adds variables up to numVar and the given constraints, root is true for the first step
+            void addConstraints(unsigned int numVar, GecodeSolver::ConstraintMap& constraints,
+                                LParseGlobalConstraintPrinter::GCvec& gcvec, bool root);
             virtual void constrain(const Space& b);
             void propagate(const Clasp::LitVec::const_iterator& lvstart, const Clasp::LitVec::const_iterator& lvend);
             void propagate(const Clasp::Literal& i);
@@ -283,12 +318,16 @@ namespace Clingcon {
             // delete litToVar and all shared memory between the spaces
             void cleanAll();
         private:
-            void generateConstraint(const Constraint* c, unsigned int boolvar);
+            void generateConstraint(const Constraint* c, BoolVar b);
             void generateConstraint(const Constraint* c, bool val);
             Gecode::LinRel generateLinearRelation(const Constraint* c);
             Gecode::BoolExpr generateBooleanExpression(const Constraint* c);
             //void generateLinearConstraint(CSPSolver* csps, const GroundConstraint* c, IntArgs& args, IntVarArgs& array, unsigned int num);
             void generateGlobalConstraint(LParseGlobalConstraintPrinter::GC& gc);
+            // decomposes the global constraint into reified relations whose conjunction is holds
+            void generateGlobalConstraint(LParseGlobalConstraintPrinter::GC& gc, BoolVar holds);
+            // the guarded constraint lit only has to agree with its variable in r_ while step is false
+            void generateGuard(Clasp::Literal lit, Clasp::Literal step);
             Gecode::LinExpr generateLinearExpr(const GroundConstraint* c);
             Gecode::LinExpr generateSum(std::vector<std::pair<GroundConstraint*,bool> >& vec);
             Gecode::LinExpr generateSum(std::vector<std::pair<GroundConstraint*,bool> >& vec, size_t i);
@@ -296,6 +335,8 @@ namespace Clingcon {
 
             IntVarArray x_;
             BoolVarArray b_;
+            BoolVarArray r_; // reification of guarded constraints, b_ equals r_ as long as one of their guards holds
+            Waitress* waitress_; // watches the reified constraints, only set in the root space
 
             //i do it static to now to blow up the space
             static IntVarArgs iva_; // for collecting temporary variables
@@ -177,6 +177,9 @@ namespace Clingcon
             virtual void beginHead(CSPLit::Type cmp) = 0;
             virtual void addHead(GroundedConstraintVarLitVec& vec) = 0;
             virtual void endHead() = 0;
+            // the constraint only has to hold if its body holds,
+            // the body literals are printed afterwards via the Rule::Printer
+            virtual void beginBody() = 0;
             virtual void end() = 0;
             virtual ~Printer();
         };
@@ -228,6 +231,22 @@ namespace Clingcon
                     t=GlobalConstraintHeadLit::At;
                     break;
                 }
+                case CUMULATIVE:
+                {
+                    if (i<3)
+                        t=GlobalConstraintHeadLit::Index;
+                    else
+                        t=GlobalConstraintHeadLit::Weight;
+                    break;
+                }
+                case ELEMENT:
+                {
+                    if (i==0)
+                        t=GlobalConstraintHeadLit::Index;
+                    else
+                        t=GlobalConstraintHeadLit::Weight;
+                    break;
+                }
                 default: assert(false);
 
                 }
@@ -286,6 +305,22 @@ namespace Clingcon
                     t=GlobalConstraintHeadLit::At;
                     break;
                 }
+                case CUMULATIVE:
+                {
+                    if (i<3)
+                        t=GlobalConstraintHeadLit::Index;
+                    else
+                        t=GlobalConstraintHeadLit::Weight;
+                    break;
+                }
+                case ELEMENT:
+                {
+                    if (i==0)
+                        t=GlobalConstraintHeadLit::Index;
+                    else
+                        t=GlobalConstraintHeadLit::Weight;
+                    break;
+                }
                 default: assert(false);
 
                 }
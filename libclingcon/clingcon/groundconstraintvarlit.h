@@ -15,9 +15,23 @@ namespace Clingcon
         MINIMIZE_SET,
         MINIMIZE,
         MAXIMIZE_SET,
-        MAXIMIZE
+        MAXIMIZE,
+        CUMULATIVE,
+        ELEMENT
     };
 
+    // true if head i of a global constraint of type t is a single term compared via cmp_
+    inline bool isCmpHead(GCType t, size_t i)
+    {
+        return ((t==COUNT || t==COUNT_UNIQUE) && i==1) || (t==CUMULATIVE && i==3) || (t==ELEMENT && i==2);
+    }
+
+    // true if a global constraint of type t can be posted reified on an atom, so its body need not be decided by grounding
+    inline bool isReifiable(GCType t)
+    {
+        return t==DISTINCT || t==BINPACK || t==COUNT || t==COUNT_UNIQUE || t==ELEMENT;
+    }
+
     struct GroundedConstraintVarLit
     {
         GroundedConstraintVarLit() : vt_(0), vweight_(Val::number(0))
@@ -1,7 +1,8 @@
 #pragma once
 
 
-#include <list>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 
 template <class T>
@@ -17,138 +18,117 @@ class IntervalSet
 {
 public:
 	typedef Interval<T> ValueType;
-	typedef std::list<ValueType> IntervalList;
-        typedef typename IntervalList::iterator Iterator;
-        typedef typename IntervalList::const_iterator ConstIterator;
+	typedef std::vector<ValueType> IntervalVec;
+        typedef typename IntervalVec::iterator Iterator;
+        typedef typename IntervalVec::const_iterator ConstIterator;
 
 
 public:
 	ConstIterator begin() const
 	{
-		return list_.begin();
+		return vec_.begin();
 	}
 
 	ConstIterator end() const
 	{
-		return list_.end();
+		return vec_.end();
 	}
 
-        typename IntervalList::size_type size() const
+        typename IntervalVec::size_type size() const
         {
-            return list_.size();
+            return vec_.size();
+        }
+
+        bool empty() const
+        {
+            return vec_.empty();
+        }
+
+        // smallest element, pre: !empty()
+        T lower() const
+        {
+            return vec_.front().left;
+        }
+
+        // one past the largest element, pre: !empty()
+        T upper() const
+        {
+            return vec_.back().right;
         }
 
 	void unite(const ValueType &v)
 	{
-        if (list_.size())
-            unite(v, list_.begin());
-        else
-            list_.push_back(v);
+		if (!(v.left < v.right)) { return; }
+		// first interval that touches or follows v
+		Iterator first = std::lower_bound(vec_.begin(), vec_.end(), v.left, RightBefore());
+		// first interval that follows v without touching it
+		Iterator last  = std::upper_bound(first, vec_.end(), v.right, LeftAfter());
+		if (first == last) { vec_.insert(first, v); }
+		else
+		{
+			first->left  = std::min(first->left, v.left);
+			first->right = std::max((last - 1)->right, v.right);
+			vec_.erase(first + 1, last);
+		}
 	}
 
 	void unite(const IntervalSet<T> &iv)
 	{
-		Iterator j = list_.begin();
-		for (ConstIterator i = iv.list_.begin(); i != iv.list_.end(); i++)
+		if (iv.vec_.empty()) { return; }
+		if (vec_.empty()) { vec_ = iv.vec_; return; }
+		if (iv.vec_.size() == 1) { unite(iv.vec_.front()); return; }
+		IntervalVec ret;
+		ret.reserve(vec_.size() + iv.vec_.size());
+		ConstIterator i = vec_.begin(), j = iv.vec_.begin();
+		while (i != vec_.end() || j != iv.vec_.end())
 		{
-			j = unite(*i, j);
-		} 
+			const ValueType &next = (j == iv.vec_.end() || (i != vec_.end() && i->left < j->left)) ? *i++ : *j++;
+			if (!ret.empty() && !(ret.back().right < next.left)) { ret.back().right = std::max(ret.back().right, next.right); }
+			else { ret.push_back(next); }
+		}
+		vec_.swap(ret);
 	}
 
 	void intersect(const IntervalSet<T> &iv)
 	{
-		Iterator j = list_.begin();
-		for (ConstIterator i = iv.list_.begin(); i != iv.list_.end() && j != list_.end(); )
+		IntervalVec ret;
+		ConstIterator i = vec_.begin(), j = iv.vec_.begin();
+		while (i != vec_.end() && j != iv.vec_.end())
 		{
-			if (i->left >= j->right)
-			{
-				j = list_.erase(j);
-			}
-			else if(i->right <= j->left)
-			{
-				i++;
-			}
-			else
-			{
-
-                                if (i->right < j->right)
-                                {
-                                    ValueType add(std::max(j->left, i->left), i->right);
-                                    j = list_.insert(j,add);
-                                    ++j;
-                                    ++i;
-
-                                }
-                                else
-                                {
-                                    j->left  = std::max(j->left, i->left);
-                                    j->right;// = std::min(j->right, i->right);
-                                    j++;
-                                }
-			}
+			T left  = std::max(i->left, j->left);
+			T right = std::min(i->right, j->right);
+			if (left < right) { ret.push_back(ValueType(left, right)); }
+			if (i->right < j->right) { ++i; }
+			else { ++j; }
 		}
-		list_.erase(j, list_.end());
+		vec_.swap(ret);
 	}
 
 	void complement(ValueType const &iv)
 	{
+		IntervalVec ret;
 		T left = iv.left;
-		for (Iterator j = list_.begin(); j != list_.end(); )
+		for (ConstIterator j = vec_.begin(); j != vec_.end() && j->left < iv.right; ++j)
 		{
-			T right  = std::min(j->right, iv.right);
-                        if (j->left <= left)
-			{
-				j = list_.erase(j);
-			}
-			else
-			{
-				j->right = j->left;
-				j->left  = left;
-				j++;
-			}
-			left = right;
+			if (left < j->left) { ret.push_back(ValueType(left, j->left)); }
+			left = std::max(left, j->right);
 		}
-		if (left < iv.right) { list_.push_back(ValueType(left, iv.right)); }
+		if (left < iv.right) { ret.push_back(ValueType(left, iv.right)); }
+		vec_.swap(ret);
 	}
 
 private:
-	Iterator unite(const ValueType &v, const Iterator &it)
+	struct RightBefore
 	{
-		for (Iterator j = it; j != list_.end(); j++)
-		{
-			if (v.left < j->left)
-			{
-				if (v.right < j->left) { return list_.insert(j, v); }
-				else
-				{
-					j->left = v.left;
-					j->right = std::max(j->right, v.right);
-					fix(j);
-					return j;
-				}
-			}
-			else if (v.left <= j->right)
-			{
-				j->right = std::max(j->right, v.right);
-				fix(j);
-				return j;
-			}
-
-		}
-		list_.push_back(v);
-	}
-
-	void fix(const Iterator &j)
+		bool operator()(const ValueType &a, T const &x) const { return a.right < x; }
+	};
+	struct LeftAfter
 	{
-		Iterator i = j;
-		Iterator k = ++i;
-		for (; k != list_.end() && j->right >= k->left; k++) { };
-		j->right = std::max(j->right, (--k)->right);
-		list_.erase(i, ++k);
-	}
+		bool operator()(T const &x, const ValueType &a) const { return x < a.left; }
+	};
 
 private:
-	IntervalList list_;
+	IntervalVec vec_;
 };
 
 template <class T>
@@ -5,6 +5,7 @@
 #include <clingcon/constraintterm.h>
 //#include <clingcon/cspprinter.h>
 #include <gringo/litdep.h>
+#include <gringo/profile.h>
 #include <clingcon/globalconstraint.h>
 
 namespace Clingcon
@@ -138,7 +139,9 @@ namespace Clingcon
 
     void ConstraintVarCond::ground(Grounder *g)
     {
+            double start = g->profile() ? Profile::now() : 0;
             inst_->ground(g);
+            if(g->profile()) { g->profile()->grounded(this, inst_.get(), Profile::now() - start); }
     }
 
 
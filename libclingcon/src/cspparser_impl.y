@@ -361,10 +361,28 @@ globalconstrainthead(res) ::= CSPDISTINCT(tok) LCBRAC condsetlist(list) RCBRAC.
                     list->push_back(vec1(temp));
                     res = new boost::tuple<CSPParser::Token, Clingcon::GCType, boost::ptr_vector<ConstraintVarCondPtrVec>* , Clingcon::CSPLit::Type>(tok, Clingcon::COUNT_UNIQUE,list, cmp);
                     }
- //globalconstrainthead(res) ::= CSPCOUNT(tok) LCBRAC condsetlist(list1) RCBRAC LSBRAC condindexlist(list2) RSBRAC.  {
- //                   boost::ptr_vector<ConstraintVarCondPtrVec>* list = vec1(list1); list->push_back(list2);
- //                   res = new boost::tuple<CSPParser::Token, Clingcon::GCType, boost::ptr_vector<ConstraintVarCondPtrVec>* >(tok, Clingcon::COUNT_GLOBAL,list);
- //                   }
+ globalconstrainthead(res) ::= CSPCOUNT(tok) LCBRAC condsetlist(list1) RCBRAC LSBRAC condatlist(list2) RSBRAC.  {
+                    boost::ptr_vector<ConstraintVarCondPtrVec>* list = vec1(list1); list->push_back(list2);
+                    res = new boost::tuple<CSPParser::Token, Clingcon::GCType, boost::ptr_vector<ConstraintVarCondPtrVec>* >(tok, Clingcon::COUNT_GLOBAL,list);
+                    }
+
+ globalconstraintcounthead(res) ::= CSPCUMULATIVE(tok) LSBRAC condatlist(list1) RSBRAC LSBRAC condatlist(list2) RSBRAC LSBRAC condatlist(list3) RSBRAC cspcmp(cmp) constraintterm(t).  {
+                    boost::ptr_vector<ConstraintVarCondPtrVec>* list = vec1(list1);
+                    list->push_back(list2);
+                    list->push_back(list3);
+                    LitPtrVec empty;
+                    ConstraintVarCond* temp = new ConstraintVarCond(tok.loc(), ONE(tok.loc()),t, empty);
+                    list->push_back(vec1(temp));
+                    res = new boost::tuple<CSPParser::Token, Clingcon::GCType, boost::ptr_vector<ConstraintVarCondPtrVec>* , Clingcon::CSPLit::Type>(tok, Clingcon::CUMULATIVE,list, cmp);
+                    }
+
+ globalconstraintcounthead(res) ::= CSPELEMENT(tok) LSBRAC condatlist(list1) RSBRAC LSBRAC constraintterm(index) RSBRAC cspcmp(cmp) constraintterm(t).  {
+                    boost::ptr_vector<ConstraintVarCondPtrVec>* list = vec1(list1);
+                    LitPtrVec empty;
+                    list->push_back(vec1(new ConstraintVarCond(tok.loc(), ONE(tok.loc()),index, empty)));
+                    list->push_back(vec1(new ConstraintVarCond(tok.loc(), ONE(tok.loc()),t, empty)));
+                    res = new boost::tuple<CSPParser::Token, Clingcon::GCType, boost::ptr_vector<ConstraintVarCondPtrVec>* , Clingcon::CSPLit::Type>(tok, Clingcon::ELEMENT,list, cmp);
+                    }
 
  globalconstrainthead(res) ::= CSPMINIMIZE(tok) LCBRAC condatlist(list1) RCBRAC.  {
                     boost::ptr_vector<ConstraintVarCondPtrVec>* list = vec1(list1);
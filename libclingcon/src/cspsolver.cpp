@@ -24,7 +24,7 @@
 namespace Clingcon {
 
 
-CSPSolver::CSPSolver() : optimize_(false), domain_(std::numeric_limits<int>::min(), std::numeric_limits<int>::max())
+CSPSolver::CSPSolver() : aspEnumerator_(0), optimize_(false), domain_(std::numeric_limits<int>::min(), std::numeric_limits<int>::max())
 {
 
 }
@@ -83,6 +83,36 @@ void CSPSolver::addGlobalConstraints(LParseGlobalConstraintPrinter::GCvec& gcvec
 {
     globalConstraints_ = gcvec.release();
 }
+
+const LParseGlobalConstraintPrinter::GCvec& CSPSolver::getGlobalConstraints() const
+{
+    return globalConstraints_;
+}
+
+void CSPSolver::retireConstraint(int uid)
+{
+    retiredUids_.push_back(uid);
+}
+
+void CSPSolver::guardConstraint(int uid, int stepUid)
+{
+    guardUids_.push_back(std::make_pair(uid, stepUid));
+}
+
+void CSPSolver::setAspMinimize(const LparseConverter::AtomVec &pos, const LparseConverter::AtomVec &neg,
+                               const LparseConverter::WeightVec &wPos, const LparseConverter::WeightVec &wNeg)
+{
+    aspMinimizeUids_.clear();
+    for (size_t i = 0; i < neg.size(); ++i)
+        aspMinimizeUids_.push_back(std::make_pair(-static_cast<int>(neg[i]), wNeg[i]));
+    for (size_t i = 0; i < pos.size(); ++i)
+        aspMinimizeUids_.push_back(std::make_pair(static_cast<int>(pos[i]), wPos[i]));
+}
+
+void CSPSolver::setAspEnumerator(const Clasp::Enumerator* en)
+{
+    aspEnumerator_ = en;
+}
 /*
 void CSPSolver::addDomain(const std::string& var, int lower, int upper)
 {
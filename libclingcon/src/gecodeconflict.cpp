@@ -437,6 +437,31 @@ CCIISCA::CCIISCA(GecodeSolver *g) : g_(g), props_(0), numCalls_(0), sumLength_(0
             std::cout << x << "\t:" << varSets_[i->first][x] << std::endl;
             */
     }
+    for (CSPSolver::GlobalLitMap::const_iterator i = g->globalLits_.begin(); i != g->globalLits_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        std::vector<unsigned int> vec;
+        i->first->getAllVariables(vec,g);
+        for (std::vector<unsigned int>::const_iterator v = vec.begin(); v != vec.end(); ++v)
+            varSets_[i->second.var()].set(*v);
+    }
+    // a step literal depends on the variables of the constraints it guards
+    for (CSPSolver::GuardVec::const_iterator i = g->guards_.begin(); i != g->guards_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->second.var()] |= varSets_[i->first.var()];
+    }
+    // the bound on the asp minimize statement connects its literals
+    VarSet minimize(g->getVariables().size());
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            minimize |= varSets_[i->first.var()];
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->first.var()] |= minimize;
 }
 
 
@@ -598,6 +623,31 @@ CCRangeCA::CCRangeCA(GecodeSolver *g) : g_(g), props_(0), numCalls_(0), sumLengt
         for (std::vector<unsigned int>::const_iterator v = vec.begin(); v != vec.end(); ++v)
             varSets_[i->first.var()].set(*v);
     }
+    for (CSPSolver::GlobalLitMap::const_iterator i = g->globalLits_.begin(); i != g->globalLits_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        std::vector<unsigned int> vec;
+        i->first->getAllVariables(vec,g);
+        for (std::vector<unsigned int>::const_iterator v = vec.begin(); v != vec.end(); ++v)
+            varSets_[i->second.var()].set(*v);
+    }
+    // a step literal depends on the variables of the constraints it guards
+    for (CSPSolver::GuardVec::const_iterator i = g->guards_.begin(); i != g->guards_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->second.var()] |= varSets_[i->first.var()];
+    }
+    // the bound on the asp minimize statement connects its literals
+    VarSet minimize(g->getVariables().size());
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            minimize |= varSets_[i->first.var()];
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->first.var()] |= minimize;
 }
 
 void CCRangeCA::shrink(Clasp::LitVec& conflict, bool last)
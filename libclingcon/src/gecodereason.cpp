@@ -287,6 +287,31 @@ CCIRSRA::CCIRSRA(GecodeSolver *g) : g_(g), props_(0), numCalls_(0), sumLength_(0
             std::cout << x << "\t:" << varSets_[i->first][x] << std::endl;
             */
     }
+    for (CSPSolver::GlobalLitMap::const_iterator i = g->globalLits_.begin(); i != g->globalLits_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        std::vector<unsigned int> vec;
+        i->first->getAllVariables(vec,g);
+        for (std::vector<unsigned int>::const_iterator v = vec.begin(); v != vec.end(); ++v)
+            varSets_[i->second.var()].set(*v);
+    }
+    // a step literal depends on the variables of the constraints it guards
+    for (CSPSolver::GuardVec::const_iterator i = g->guards_.begin(); i != g->guards_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->second.var()] |= varSets_[i->first.var()];
+    }
+    // the bound on the asp minimize statement connects its literals
+    VarSet minimize(g->getVariables().size());
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            minimize |= varSets_[i->first.var()];
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->first.var()] |= minimize;
 }
 
 void CCIRSRA::generate(Clasp::LitVec& reason, const Clasp::Literal& l, const Clasp::LitVec::const_iterator& begin, const Clasp::LitVec::const_iterator& ends)
@@ -433,6 +458,31 @@ CCRangeRA::CCRangeRA(GecodeSolver *g) : g_(g), props_(0), numCalls_(0), sumLengt
             std::cout << x << "\t:" << varSets_[i->first][x] << std::endl;
             */
     }
+    for (CSPSolver::GlobalLitMap::const_iterator i = g->globalLits_.begin(); i != g->globalLits_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        std::vector<unsigned int> vec;
+        i->first->getAllVariables(vec,g);
+        for (std::vector<unsigned int>::const_iterator v = vec.begin(); v != vec.end(); ++v)
+            varSets_[i->second.var()].set(*v);
+    }
+    // a step literal depends on the variables of the constraints it guards
+    for (CSPSolver::GuardVec::const_iterator i = g->guards_.begin(); i != g->guards_.end(); ++i)
+    {
+        if (varSets_.find(i->second.var()) == varSets_.end())
+            varSets_.insert(std::make_pair(i->second.var(),VarSet(g->getVariables().size())));
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->second.var()] |= varSets_[i->first.var()];
+    }
+    // the bound on the asp minimize statement connects its literals
+    VarSet minimize(g->getVariables().size());
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            minimize |= varSets_[i->first.var()];
+    for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = g->aspMinimize_.begin(); i != g->aspMinimize_.end(); ++i)
+        if (varSets_.find(i->first.var()) != varSets_.end())
+            varSets_[i->first.var()] |= minimize;
 }
 
 void CCRangeRA::generate(Clasp::LitVec& reason, const Clasp::Literal& l, const Clasp::LitVec::const_iterator& begin, const Clasp::LitVec::const_iterator& ends)
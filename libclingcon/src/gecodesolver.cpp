@@ -23,11 +23,14 @@
 #include <clasp/program_builder.h>
 #include <clasp/solver.h>
 #include <clingcon/propagator.h>
+#include <clasp/enumerator.h>
+#include <clasp/minimize_constraint.h>
 #include <gecode/search.hh>
 #include <gecode/int.hh>
 #include <gecode/minimodel.hh>
 #include <exception>
 #include <sstream>
+#include <algorithm>
 #include <clingcon/cspconstraint.h>
 #include <gringo/litdep.h>
 #include <gecode/kernel/wait.hh>
@@ -73,7 +76,7 @@ GecodeSolver::GecodeSolver(bool lazyLearn, bool weakAS, int numAS,
                            const std::string& reduceConflict, unsigned int cspPropDelay, unsigned int cloning) :
     /*currentSpace_(0),*/ lazyLearn_(lazyLearn), weakAS_(weakAS), numAS_(numAS), enumerator_(0), dfsSearchEngine_(0), babSearchEngine_(0),
     dummyReason_(this), updateOpt_(false), conflictAnalyzer_(0), reasonAnalyzer_(0), recording_(true),
-    initialLookahead_(initialLookahead), cspPropDelay_(abs(cspPropDelay)), cspPropDelayCounter_(1), propagated_(0), deepCopy_(cloning), deepCopyCounter_(0)
+    initialLookahead_(initialLookahead), cspPropDelay_(abs(cspPropDelay)), cspPropDelayCounter_(1), propagated_(0), deepCopy_(cloning), deepCopyCounter_(0), aspBound_(Int::Limits::max)
 {
     if (deepCopy_==0) deepCopyCounter_=1;
     optValues.insert(optValues.end(),optValueVec.begin(), optValueVec.end());
@@ -156,9 +159,12 @@ GecodeSolver::~GecodeSolver()
 }
 
 
-void GecodeSolver::propagateLiteral(const Clasp::Literal& l, int)
+bool GecodeSolver::propagateLiteral(const Clasp::Literal& l, int)
 {
+    if (l.var() < retiredVars_.size() && retiredVars_[l.var()])
+        return false;
     propQueue_.push_back(l);
+    return true;
 }
 
 void GecodeSolver::reset()
@@ -210,11 +216,105 @@ GecodeSolver::SearchSpace* GecodeSolver::getCurrentSpace()
     }
 }
 
-bool GecodeSolver::initialize()
+void GecodeSolver::resetSearch()
 {
+    delete dfsSearchEngine_;
+    delete babSearchEngine_;
+    delete enumerator_;
     dfsSearchEngine_ = 0;
     babSearchEngine_ = 0;
     enumerator_ = 0;
+
+    // only the root space survives a step
+    for (size_t i = 1; i < spaces_.size(); ++i)
+        delete spaces_[i];
+    spaces_.resize(std::min<size_t>(spaces_.size(), 1));
+    dl_.assign(spaces_.size(), 0);
+    assLength_.assign(spaces_.size(), 0);
+    assignment_.clear();
+    propagated_ = 0;
+    derivedLits_.clear();
+    impliedLits_.clear();
+    litToAssPosition_.clear();
+    propQueue_.clear();
+}
+
+void GecodeSolver::retireConstraints()
+{
+    for (std::vector<int>::const_iterator u = retiredUids_.begin(); u != retiredUids_.end(); ++u)
+    {
+        AtomIndex::const_iterator it = s_->strategies().symTab->lower_bound(s_->strategies().symTab->begin(), *u);
+        if (it == s_->strategies().symTab->end() || it->first != static_cast<Clasp::Var>(*u))
+            continue;
+        Clasp::Literal lit = it->second.lit;
+        GecodeSolver::ConstraintMap::iterator c = oldConstraints_.find(lit);
+        if (c == oldConstraints_.end())
+            continue;
+        // its guards are already switched off, the analyzers forget it and clasp drops its watches
+        oldConstraints_.erase(c);
+        guardIndex_.erase(lit);
+        if (retiredVars_.size() <= lit.var())
+            retiredVars_.resize(lit.var()+1, false);
+        retiredVars_[lit.var()] = true;
+    }
+    retiredUids_.clear();
+}
+
+void GecodeSolver::initGuards()
+{
+    newGuards_.clear();
+    for (std::vector<std::pair<int,int> >::const_iterator g = guardUids_.begin(); g != guardUids_.end(); ++g)
+    {
+        Clasp::Literal lit = s_->strategies().symTab->lower_bound(s_->strategies().symTab->begin(), g->first)->second.lit;
+        Clasp::Literal step = posLit(0);
+        if (g->second)
+        {
+            step = s_->strategies().symTab->lower_bound(s_->strategies().symTab->begin(), g->second)->second.lit;
+            if (!s_->isTrue(step) && std::find(stepLits_.begin(), stepLits_.end(), step) == stepLits_.end())
+            {
+                stepLits_.push_back(step);
+                if (!s_->isFalse(step))
+                {
+                    s_->addWatch(step, clingconPropagator_,0);
+                    s_->addWatch(~step, clingconPropagator_,0);
+                }
+            }
+        }
+        newGuards_[lit].push_back(step);
+    }
+    guardUids_.clear();
+}
+
+bool GecodeSolver::guarded(Clasp::Literal lit) const
+{
+    GuardMap::const_iterator g = newGuards_.find(lit);
+    return g != newGuards_.end() && std::find(g->second.begin(), g->second.end(), posLit(0)) == g->second.end();
+}
+
+void GecodeSolver::retireSteps()
+{
+    Clasp::LitVec::iterator j = stepLits_.begin();
+    for (Clasp::LitVec::iterator i = stepLits_.begin(); i != stepLits_.end(); ++i)
+    {
+        if (s_->isTrue(*i))
+        {
+            // gecode cannot remove propagators, fixing the step literal switches off its guards in the kept root space
+            if (litToIndex_.find(*i) != litToIndex_.end() && !spaces_[0]->failed())
+                spaces_[0]->propagate(*i);
+            if (retiredVars_.size() <= i->var())
+                retiredVars_.resize(i->var()+1, false);
+            retiredVars_[i->var()] = true;
+        }
+        else
+            *j++ = *i;
+    }
+    stepLits_.erase(j, stepLits_.end());
+}
+
+bool GecodeSolver::initialize()
+{
+    resetSearch();
+    retireConstraints();
     if (optimize_)
     {
         weakAS_=false;
@@ -240,6 +340,7 @@ bool GecodeSolver::initialize()
     // Convert uids to solver literal ids
     // Guess initial domains of level0 constraints        //if (tester->failed() || tester->status()==Gecode::SS_FAILED)
     GecodeSolver::ConstraintMap newConstraints;
+    DecidedVec binary; // decided constraints between two variables
     AtomIndex::const_iterator begin = s_->strategies().symTab->begin();
     GecodeSolver::ConstraintMap::iterator i = constraints_.begin();
     while(i != constraints_.end())
@@ -249,19 +350,32 @@ bool GecodeSolver::initialize()
 
         Clasp::Literal newLit = begin->second.lit;
 
+        // the same solver literal was already posted in an earlier step
+        if (oldConstraints_.find(newLit) != oldConstraints_.end())
+        {
+            constraints_.erase(i);
+            i = constraints_.begin();
+            continue;
+        }
+        if (newLit.var() < retiredVars_.size())
+            retiredVars_[newLit.var()] = false;
+
         // convert uids to solver literal ids
 
         i->second->registerAllVariables(this);
 
         //guess domains of already decided constraints
-        if (s_->isTrue(newLit))
+        if (s_->isTrue(newLit) || s_->isFalse(newLit))
         {
-            guessDomains(i->second, true);
-        }
-        else
-        if (s_->isFalse(newLit))
-        {
-            guessDomains(i->second, false);
+            guessDomains(i->second, s_->isTrue(newLit));
+            const GroundConstraint* a(0);
+            const GroundConstraint* b(0);
+            if (i->second->isSimple())
+            {
+                i->second->getRelations(a,b);
+                if (a->isVariable() && b->isVariable())
+                    binary.push_back(std::make_pair(i->second, s_->isTrue(newLit)));
+            }
         }
         else
         {
@@ -277,24 +391,60 @@ bool GecodeSolver::initialize()
     constraints_.swap(newConstraints);
 
     for (LParseGlobalConstraintPrinter::GCvec::iterator i = globalConstraints_.begin(); i != globalConstraints_.end(); ++i)
+    {
         for (boost::ptr_vector<IndexedGroundConstraintVec>::iterator j = i->heads_.begin(); j != i->heads_.end(); ++j)
             for (IndexedGroundConstraintVec::iterator k = j->begin(); k != j->end(); ++k)
             {
                 k->a_->registerAllVariables(this);
                 k->b_.registerAllVariables(this);
             }
+        if (i->atom_)
+        {
+            // global constraints with a body are reified like the other constraints
+            Clasp::Literal lit = s_->strategies().symTab->lower_bound(s_->strategies().symTab->begin(), i->atom_)->second.lit;
+            globalLits_[&*i] = lit;
+            if (!s_->isTrue(lit) && !s_->isFalse(lit))
+            {
+                s_->addWatch(lit, clingconPropagator_,0);
+                s_->addWatch(~lit, clingconPropagator_,0);
+            }
+        }
+    }
 
     // End
     /////////
 
+    initGuards();
+    boundDomains(binary);
 
-    // propagate empty constraint set, maybe some trivial constraints can be fullfilled
-    spaces_.push_back(new SearchSpace(this, variables_.size(), constraints_, globalConstraints_)); // special root space
-    dl_.push_back(0);
-    assLength_.push_back(0);
+    if (spaces_.empty())
+    {
+        // propagate empty constraint set, maybe some trivial constraints can be fullfilled
+        spaces_.push_back(new SearchSpace(this, variables_.size(), constraints_, globalConstraints_)); // special root space
+        dl_.push_back(0);
+        assLength_.push_back(0);
+    }
+    else
+    {
+        // incremental step, only add the new constraints to the propagated root space
+        spaces_[0]->addConstraints(variables_.size(), constraints_, globalConstraints_, false);
+    }
+    retireSteps();
 
+    for (std::vector<std::pair<int,int> >::const_iterator i = aspMinimizeUids_.begin(); i != aspMinimizeUids_.end(); ++i)
+    {
+        // only atoms known to the solver, lower_bound might give another one
+        AtomIndex::const_iterator it = s_->strategies().symTab->lower_bound(s_->strategies().symTab->begin(), abs(i->first));
+        if (it != s_->strategies().symTab->end() && it->first == static_cast<Clasp::Var>(abs(i->first)))
+            aspMinimize_.push_back(std::make_pair(i->first < 0 ? ~it->second.lit : it->second.lit, i->second));
+    }
+    aspMinimizeUids_.clear();
 
+    // the analyzers need to know all constraints of all steps
+    constraints_.transfer(oldConstraints_);
 
+    delete conflictAnalyzer_;
+    delete reasonAnalyzer_;
     switch(reduceConflict_)
     {
         case SIMPLE:         conflictAnalyzer_ = new SimpleCA(); break;
@@ -317,8 +467,8 @@ bool GecodeSolver::initialize()
         default: assert(false);
     };
 
-    constraints_.clear();
-    globalConstraints_.clear();
+    oldConstraints_.transfer(constraints_);
+    oldGlobalConstraints_.transfer(oldGlobalConstraints_.end(), globalConstraints_);
 
     if(!getCurrentSpace()->failed() && getCurrentSpace()->updateOptValues() && !getCurrentSpace()->failed() && getCurrentSpace()->status() != SS_FAILED)
     {
@@ -377,13 +527,11 @@ bool GecodeSolver::initialize()
                     }
                 }
             }
-            variableMap_.clear();
             return true;
         }
     }
     else
     {
-        variableMap_.clear();
         propQueue_.push_back(negLit(0));
         return false;
     }
@@ -400,7 +548,7 @@ void GecodeSolver::newlyDerived(Clasp::Literal lit)
 }
 
 
-void addToDomain(GecodeSolver::DomainMap& domain,  const GecodeSolver::DomainMap& add);
+void addToDomain(GecodeSolver::DomainVec& domain,  const GecodeSolver::DomainMap& add, const GecodeSolver::Domain& def);
 GecodeSolver::DomainMap intersect(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b);
 GecodeSolver::DomainMap unite(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b);
 GecodeSolver::DomainMap xorit(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b);
@@ -413,7 +561,9 @@ void GecodeSolver::guessDomains(const Constraint* c, bool val)
         for (DomainMap::iterator i = dom.begin(); i != dom.end(); ++i)
             i->second.complement(Interval<int>(Int::Limits::min, Int::Limits::max+1));
 
-    addToDomain(domains_, dom);
+    Domain def;
+    def.unite(domain_);
+    addToDomain(domains_, dom, def);
 }
 
 GecodeSolver::DomainMap GecodeSolver::guessDomainsImpl(const Constraint* c)
@@ -484,12 +634,161 @@ GecodeSolver::DomainMap GecodeSolver::guessDomainsImpl(const Constraint* c)
             var = getVariable(b->getString());
             value = a->getInteger();
         }
-        m[var] = getSet(var, comp, value);
+        m.push_back(std::make_pair(var, getSet(var, comp, value)));
         return m;
     }
     return m;
 }
 
+bool GecodeSolver::isDomainConstraint(const Constraint* c, unsigned int& var)
+{
+    if (!c->isSimple())
+        return false;
+    const GroundConstraint* a(0);
+    const GroundConstraint* b(0);
+    c->getRelations(a,b);
+    if (a->isVariable() && b->isInteger())
+        var = getVariable(a->getString());
+    else if (b->isVariable() && a->isInteger())
+        var = getVariable(b->getString());
+    else
+        return false;
+    return true;
+}
+
+namespace
+{
+    // restrict d to [left,right), returns true if d changed
+    bool restrictDomain(GecodeSolver::Domain& d, int left, int right)
+    {
+        if (d.empty() || (d.lower() >= left && d.upper() <= right))
+            return false;
+        GecodeSolver::Domain bound;
+        if (left < right)
+            bound.unite(GecodeSolver::IntInterval(left, right));
+        d.intersect(bound);
+        return true;
+    }
+
+    CSPLit::Type negate(CSPLit::Type t)
+    {
+        switch(t)
+        {
+        case CSPLit::GREATER: return CSPLit::LEQUAL;
+        case CSPLit::LOWER:   return CSPLit::GEQUAL;
+        case CSPLit::GEQUAL:  return CSPLit::LOWER;
+        case CSPLit::LEQUAL:  return CSPLit::GREATER;
+        case CSPLit::EQUAL:   return CSPLit::INEQUAL;
+        case CSPLit::INEQUAL: return CSPLit::EQUAL;
+        default:              return t;
+        }
+    }
+}
+
+void GecodeSolver::boundDomains(const DecidedVec& binary)
+{
+    if (binary.empty())
+        return;
+
+    // bounds propagation converges slowly on cycles like X $< Y, Y $< X,
+    // gecode will detect these, so we only do a fixed number of rounds
+    const unsigned int maxRounds = 16;
+    bool changed = true;
+    for (unsigned int round = 0; changed && round < maxRounds; ++round)
+    {
+        changed = false;
+        for (DecidedVec::const_iterator i = binary.begin(); i != binary.end(); ++i)
+        {
+            const GroundConstraint* a(0);
+            const GroundConstraint* b(0);
+            CSPLit::Type comp = i->first->getRelations(a,b);
+            if (!i->second)
+                comp = negate(comp);
+            if (comp == CSPLit::INEQUAL)
+                continue;
+
+            unsigned int x = getVariable(a->getString());
+            unsigned int y = getVariable(b->getString());
+            if (domains_.size() <= std::max(x,y))
+            {
+                Domain def;
+                def.unite(domain_);
+                domains_.resize(std::max(x,y)+1, def);
+            }
+            Domain& dx = domains_[x];
+            Domain& dy = domains_[y];
+            if (dx.empty() || dy.empty())
+                return; // the root space will fail anyway
+
+            // all bounds are half open intervals [lower,upper)
+            int lx = dx.lower(), ux = dx.upper();
+            int ly = dy.lower(), uy = dy.upper();
+            switch(comp)
+            {
+            case CSPLit::LOWER:
+                changed |= restrictDomain(dx, Int::Limits::min, uy-1);
+                changed |= restrictDomain(dy, lx+1, Int::Limits::max+1);
+                break;
+            case CSPLit::LEQUAL:
+                changed |= restrictDomain(dx, Int::Limits::min, uy);
+                changed |= restrictDomain(dy, lx, Int::Limits::max+1);
+                break;
+            case CSPLit::GREATER:
+                changed |= restrictDomain(dy, Int::Limits::min, ux-1);
+                changed |= restrictDomain(dx, ly+1, Int::Limits::max+1);
+                break;
+            case CSPLit::GEQUAL:
+                changed |= restrictDomain(dy, Int::Limits::min, ux);
+                changed |= restrictDomain(dx, ly, Int::Limits::max+1);
+                break;
+            case CSPLit::EQUAL:
+                changed |= restrictDomain(dx, ly, uy);
+                changed |= restrictDomain(dy, lx, ux);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
+
+namespace
+{
+    struct OrderedConstraint
+    {
+        OrderedConstraint(unsigned int arity, unsigned int var, GecodeSolver::ConstraintMap::iterator it) : arity(arity), var(var), it(it) { }
+        bool operator<(const OrderedConstraint& b) const
+        {
+            if (arity != b.arity) return arity < b.arity;
+            if (var != b.var) return var < b.var;
+            return it->first < b.it->first;
+        }
+        unsigned int arity; // number of distinct variables
+        unsigned int var;   // smallest variable, groups constraints sharing it
+        GecodeSolver::ConstraintMap::iterator it;
+    };
+}
+
+void GecodeSolver::orderConstraints(ConstraintMap& constraints, std::vector<ConstraintMap::iterator>& order)
+{
+    std::vector<OrderedConstraint> sorted;
+    sorted.reserve(constraints.size());
+    std::vector<unsigned int> vars;
+    for(ConstraintMap::iterator i = constraints.begin(); i != constraints.end(); ++i)
+    {
+        vars.clear();
+        i->second->getAllVariables(vars, this);
+        std::sort(vars.begin(), vars.end());
+        vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+        sorted.push_back(OrderedConstraint(vars.size(), vars.empty() ? 0 : vars.front(), i));
+    }
+    std::sort(sorted.begin(), sorted.end());
+    order.clear();
+    order.reserve(sorted.size());
+    for (std::vector<OrderedConstraint>::const_iterator i = sorted.begin(); i != sorted.end(); ++i)
+        order.push_back(i->it);
+}
+
 GecodeSolver::Domain GecodeSolver::getSet(unsigned int var, CSPLit::Type t, int x) const
 {
     Domain ret;
@@ -506,142 +805,100 @@ GecodeSolver::Domain GecodeSolver::getSet(unsigned int var, CSPLit::Type t, int
     return ret;
 }
 
-void addToDomain(GecodeSolver::DomainMap& domain,  const GecodeSolver::DomainMap& add)
+void addToDomain(GecodeSolver::DomainVec& domain,  const GecodeSolver::DomainMap& add, const GecodeSolver::Domain& def)
 {
-    GecodeSolver::DomainMap::iterator found = domain.begin();
-    GecodeSolver::DomainMap::iterator last = found; // last valid position
     for (GecodeSolver::DomainMap::const_iterator i = add.begin(); i != add.end(); ++i)
     {
+        if (domain.size() <= i->first)
+            domain.resize(i->first+1, def);
+        domain[i->first].intersect(i->second);
+    }
+}
 
-        found = domain.lower_bound(i->first);
+namespace
+{
+    enum Combine { C_INTERSECT, C_UNITE, C_XOR, C_EQ };
 
-        //if not found
-        if (found == domain.end())
+    // both maps are sorted by variable, so this is a linear merge
+    GecodeSolver::DomainMap combine(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b, Combine op)
+    {
+        GecodeSolver::DomainMap ret;
+        ret.reserve(std::max(a.size(), b.size()));
+        GecodeSolver::DomainMap::const_iterator i = a.begin();
+        GecodeSolver::DomainMap::const_iterator j = b.begin();
+        while (i != a.end() || j != b.end())
         {
-            domain.insert(last, std::make_pair(i->first,i->second));
+            if (j == b.end() || (i != a.end() && i->first < j->first))
+            {
+                // a variable restricted only in a is only restricted by a conjunction
+                if (op == C_INTERSECT)
+                    ret.push_back(*i);
+                ++i;
+                continue;
+            }
+            if (i == a.end() || j->first < i->first)
+            {
+                if (op == C_INTERSECT)
+                    ret.push_back(*j);
+                ++j;
+                continue;
+            }
 
+            GecodeSolver::Domain l(i->second);
+            switch(op)
+            {
+            case C_INTERSECT: l.intersect(j->second); break;
+            case C_UNITE:     l.unite(j->second);     break;
+            case C_XOR:
+            case C_EQ:
+            {
+                // xor: (a \/ b) /\ (-a \/ -b)
+                // eq:  (a /\ b) \/ (-a /\ -b)
+                GecodeSolver::Domain nega(i->second);
+                nega.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
+                GecodeSolver::Domain negb(j->second);
+                negb.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
+                if (op == C_XOR)
+                {
+                    l.unite(j->second);
+                    nega.unite(negb);
+                    l.intersect(nega);
+                }
+                else
+                {
+                    l.intersect(j->second);
+                    nega.intersect(negb);
+                    l.unite(nega);
+                }
+                break;
+            }
+            }
+            ret.push_back(std::make_pair(i->first, l));
+            ++i;
+            ++j;
         }
-        else // still not found
-        if (found->first != i->first)
-        {
-            --found;
-            // add it to the domain
-            domain.insert(found, std::make_pair(i->first,i->second));
-            last = found;
-        }
-        else // found
-        {
-            found->second.intersect(i->second);
-            last = found;
-        }
+        return ret;
     }
 }
 
 GecodeSolver::DomainMap intersect(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b)
 {
-    GecodeSolver::DomainMap ret;
-    for (GecodeSolver::DomainMap::const_iterator i = a.begin(); i != a.end(); ++i)
-    {
-        GecodeSolver::DomainMap::const_iterator found = b.find(i->first);
-
-        if (found == b.end())
-        {
-            ret[i->first] = i->second;
-        }
-        else
-        {
-            GecodeSolver::Domain inter = i->second;
-            inter.intersect(found->second);
-            ret[i->first]=inter;
-        }
-    }
-
-    // can optimize this
-    // all variables that we have only in b but not in a
-    for (GecodeSolver::DomainMap::const_iterator i = b.begin(); i != b.end(); ++i)
-    {
-        GecodeSolver::DomainMap::const_iterator found = a.find(i->first);
-
-        if (found == a.end())
-        {
-            ret[i->first] = i->second;
-        }
-    }
-    return ret;
+    return combine(a, b, C_INTERSECT);
 }
 
 GecodeSolver::DomainMap unite(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b)
 {
-    GecodeSolver::DomainMap ret;
-    for (GecodeSolver::DomainMap::const_iterator i = a.begin(); i != a.end(); ++i)
-    {
-        GecodeSolver::DomainMap::const_iterator found = b.find(i->first);
-
-        if (found == b.end())
-        {
-        }
-        else
-        {
-            GecodeSolver::Domain inter = i->second;
-            inter.unite(found->second);
-            ret[i->first]=inter;
-        }
-    }
-    return ret;
+    return combine(a, b, C_UNITE);
 }
 
 GecodeSolver::DomainMap xorit(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b)
 {
-    // (a \/ b) /\ (-a \/ -b)
-    GecodeSolver::DomainMap ret;
-    for (GecodeSolver::DomainMap::const_iterator i = a.begin(); i != a.end(); ++i)
-    {
-        GecodeSolver::DomainMap::const_iterator found = b.find(i->first);
-
-        if (found == b.end())
-        {
-        }
-        else
-        {
-            GecodeSolver::Domain l(i->second);
-            l.unite(found->second);
-            GecodeSolver::Domain nega = i->second;
-            nega.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
-            GecodeSolver::Domain negb = found->second;
-            negb.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
-            nega.unite(negb);
-            l.intersect(nega);
-            ret[i->first] = l;
-        }
-    }
-    return ret;
+    return combine(a, b, C_XOR);
 }
 
 GecodeSolver::DomainMap eq(const GecodeSolver::DomainMap& a,  const GecodeSolver::DomainMap& b)
 {
-    // (a /\ b) \/ (-a /\ -b)
-    GecodeSolver::DomainMap ret;
-    for (GecodeSolver::DomainMap::const_iterator i = a.begin(); i != a.end(); ++i)
-    {
-        GecodeSolver::DomainMap::const_iterator found = b.find(i->first);
-
-        if (found == b.end())
-        {
-        }
-        else
-        {
-            GecodeSolver::Domain l(i->second);
-            l.intersect(found->second);
-            GecodeSolver::Domain nega = i->second;
-            nega.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
-            GecodeSolver::Domain negb = found->second;
-            negb.complement(GecodeSolver::IntInterval(Int::Limits::min, Int::Limits::max+1));
-            nega.intersect(negb);
-            l.unite(nega);
-            ret[i->first]=l;
-        }
-    }
-    return ret;
+    return combine(a, b, C_EQ);
 }
 
 
@@ -795,6 +1052,8 @@ bool GecodeSolver::propagate()
     }
 
 
+    if (updateAspBound())
+        updateOpt_ = true;
     if (updateOpt_)
     {
         return propagateMinimize();
@@ -1153,6 +1412,17 @@ bool GecodeSolver::finishPropagation()
 }
 
 
+bool GecodeSolver::updateAspBound()
+{
+    if (aspMinimize_.empty() || !aspEnumerator_ || !aspEnumerator_->minimize() || s_->stats.solve.models == 0)
+        return false;
+    int64 optimum = aspEnumerator_->minimize()->getOptimum(0);
+    if (optimum >= aspBound_)
+        return false;
+    aspBound_ = static_cast<int>(optimum);
+    return true;
+}
+
  bool GecodeSolver::propagateMinimize()
  {
      impliedLits_.clear(); // dont know if this cant be done more clever
@@ -1371,22 +1641,31 @@ IntVarArgs GecodeSolver::SearchSpace::iva_;
 
 GecodeSolver::SearchSpace::SearchSpace(GecodeSolver* csps, unsigned int numVar, GecodeSolver::ConstraintMap& constraints,
                                        LParseGlobalConstraintPrinter::GCvec& gcvec) : Space(),
-    x_(*this, numVar),
-    b_()
+    x_(),
+    b_(),
+    r_(),
+    waitress_(0)
 {
     csps_ = csps;
+    addConstraints(numVar, constraints, gcvec, true);
+}
+
+void GecodeSolver::SearchSpace::addConstraints(unsigned int numVar, GecodeSolver::ConstraintMap& constraints,
+                                               LParseGlobalConstraintPrinter::GCvec& gcvec, bool root)
+{
+    if (failed())
+        return;
 
-    //initialize all variables with their domain
-    for(size_t i = 0; i < csps_->getVariables().size(); ++i)
+    //initialize all new variables with their domain
+    unsigned int oldVar = x_.size();
+    GecodeSolver::Domain def;
+    def.unite(csps_->domain_);
+    csps_->domains_.resize(numVar, def);
+    IntVarArgs x(numVar);
+    for(unsigned int i = 0; i < oldVar; ++i)
+        x[i] = x_[i];
+    for(unsigned int i = oldVar; i < numVar; ++i)
     {
-        GecodeSolver::Domain def;
-        def.unite(csps_->domain_);
-        if (csps_->domains_.find(i)==csps_->domains_.end())
-        {
-            csps_->domains_[i]=def;
-        }
-        else
-            csps_->domains_[i].intersect(def);
         typedef int Range[2];
         Range* array = new Range[csps_->domains_[i].size()];
         unsigned int count=0;
@@ -1399,45 +1678,91 @@ GecodeSolver::SearchSpace::SearchSpace(GecodeSolver* csps, unsigned int numVar,
         // if we have  an empty domain
         if (csps_->domains_[i].size()==0)
         {
+            delete[] array;
             fail();
             return;
         }
 
         IntSet is(array, csps_->domains_[i].size());
         delete[] array;
-        x_[i] = IntVar(*this, is);
+        x[i] = IntVar(*this, is);
     }
+    x_ = IntVarArray(*this, x);
 
-    csps_->domains_.clear();
+    GecodeSolver::DomainVec().swap(csps_->domains_);
 
+    // constraints with few variables first, so that initial propagation is cheap
+    std::vector<GecodeSolver::ConstraintMap::iterator> order;
+    csps_->orderConstraints(constraints, order);
 
     // set static constraints
     int numReified = 0;
-    for(GecodeSolver::ConstraintMap::iterator i = constraints.begin(); i != constraints.end(); ++i)
+    int numGuarded = 0;
+    for(std::vector<GecodeSolver::ConstraintMap::iterator>::const_iterator o = order.begin(); o != order.end(); ++o)
     {
+        GecodeSolver::ConstraintMap::iterator i = *o;
+        unsigned int var;
         if (csps_->getSolver()->value(i->first.var()) == value_free)
+        {
             ++numReified;
-        else
+            if (csps_->guarded(i->first))
+                ++numGuarded;
+        }
+        else if (!csps_->isDomainConstraint(i->second, var) || var < oldVar) // new variables already have it in their initial domain
         {
             generateConstraint(i->second,csps_->getSolver()->isTrue(i->first) == value_true);
         }
     }
+    for (size_t i = 0; i < gcvec.size(); ++i)
+    {
+        CSPSolver::GlobalLitMap::const_iterator l = csps_->globalLits_.find(&gcvec[i]);
+        if (l != csps_->globalLits_.end() && csps_->getSolver()->value(l->second.var()) == value_free)
+        {
+            ++numReified;
+            if (csps_->guarded(l->second))
+                ++numGuarded;
+        }
+    }
+    // step literals are reified like constraints
+    for (Clasp::LitVec::const_iterator s = csps_->stepLits_.begin(); s != csps_->stepLits_.end(); ++s)
+        if (csps_->litToIndex_.find(*s) == csps_->litToIndex_.end() && csps_->getSolver()->value(s->var()) == value_free)
+            ++numReified;
+
+    unsigned int counter = b_.size();
+    BoolVarArgs b(counter + numReified);
+    for(unsigned int i = 0; i < counter; ++i)
+        b[i] = b_[i];
+    for(unsigned int i = counter; i < counter + numReified; ++i)
+        b[i] = BoolVar(*this, 0, 1);
+    b_ = BoolVarArray(*this, b);
 
-    //TODO: I think the BoolVarArray is now of dynamic size, so i could use this feature to save a loop
-    b_ = BoolVarArray(*this,numReified,0,1);
-    unsigned int counter = 0;
+    unsigned int guard = r_.size();
+    BoolVarArgs r(guard + numGuarded);
+    for(unsigned int i = 0; i < guard; ++i)
+        r[i] = r_[i];
+    for(unsigned int i = guard; i < guard + numGuarded; ++i)
+        r[i] = BoolVar(*this, 0, 1);
+    r_ = BoolVarArray(*this, r);
 
-    Waitress* w = new (*this) Waitress(*this);
+    if (!waitress_)
+        waitress_ = new (*this) Waitress(*this);
 
-    for(GecodeSolver::ConstraintMap::iterator i = constraints.begin(); i != constraints.end(); ++i)
+    for(std::vector<GecodeSolver::ConstraintMap::iterator>::const_iterator o = order.begin(); o != order.end(); ++o)
     {
+        GecodeSolver::ConstraintMap::iterator i = *o;
         if (csps_->getSolver()->value(i->first.var()) == value_free)
          {
              csps_->addLitToIndex(i->first, counter);
-             generateConstraint(i->second, counter);
+             if (csps_->guarded(i->first))
+             {
+                 csps_->guardIndex_[i->first] = guard;
+                 generateConstraint(i->second, r_[guard++]);
+             }
+             else
+                 generateConstraint(i->second, b_[counter]);
              // be very careful here, we use vars to refer to constraints, but constraints are literals
              // and maybe negated literals due to equality preprocessing! Currently this is not the case
-             w->init(*this,csps_, Int::BoolView(b_[counter]), csps_->indexToLit(counter).var());
+             waitress_->init(*this,csps_, Int::BoolView(b_[counter]), csps_->indexToLit(counter).var());
              ++counter;
          }
     }
@@ -1447,9 +1772,29 @@ GecodeSolver::SearchSpace::SearchSpace(GecodeSolver* csps, unsigned int numVar,
     for (size_t i = 0; i < gcvec.size(); ++i)
     {
         if (!(gcvec[i].type_ == MINIMIZE || gcvec[i].type_ == MINIMIZE_SET || gcvec[i].type_ == MAXIMIZE || gcvec[i].type_ == MAXIMIZE_SET))
-            generateGlobalConstraint(gcvec[i]);
+        {
+            CSPSolver::GlobalLitMap::const_iterator l = csps_->globalLits_.find(&gcvec[i]);
+            if (l == csps_->globalLits_.end() || csps_->getSolver()->isTrue(l->second))
+                generateGlobalConstraint(gcvec[i]);
+            else if (csps_->getSolver()->value(l->second.var()) == value_free)
+            {
+                csps_->addLitToIndex(l->second, counter);
+                if (csps_->guarded(l->second))
+                {
+                    csps_->guardIndex_[l->second] = guard;
+                    generateGlobalConstraint(gcvec[i], r_[guard++]);
+                }
+                else
+                    generateGlobalConstraint(gcvec[i], b_[counter]);
+                waitress_->init(*this,csps_, Int::BoolView(b_[counter]), csps_->indexToLit(counter).var());
+                ++counter;
+            }
+            // else the body is false and the constraint need not hold
+        }
         else
         {
+            if (!root)
+                throw ASPmCSPException("CSP optimize statements are only supported in the base program.");
             LParseGlobalConstraintPrinter::GC& gc = gcvec[i];
             IndexedGroundConstraintVec& igcv = gc.heads_[0];
             for (size_t i = 0; i < igcv.size(); ++i)
@@ -1463,24 +1808,47 @@ GecodeSolver::SearchSpace::SearchSpace(GecodeSolver* csps, unsigned int numVar,
         }
     }
 
-    //if (GecodeSolver::optValues.size()>optimize.size())
-    GecodeSolver::optValues.resize(optimize.size(),Int::Limits::max-1);
-    if (optValues.size()>0)
-        ++optValues.back();
-    opts_ = IntVarArray(*this, optimize.size(), Int::Limits::min, Int::Limits::max);
-
+    for (Clasp::LitVec::const_iterator s = csps_->stepLits_.begin(); s != csps_->stepLits_.end(); ++s)
+    {
+        if (csps_->litToIndex_.find(*s) == csps_->litToIndex_.end() && csps_->getSolver()->value(s->var()) == value_free)
+        {
+            csps_->addLitToIndex(*s, counter);
+            waitress_->init(*this,csps_, Int::BoolView(b_[counter]), csps_->indexToLit(counter).var());
+            ++counter;
+        }
+    }
+    // guards of new constraints and new guards of guarded constraints of earlier steps
+    for (GecodeSolver::GuardMap::const_iterator g = csps_->newGuards_.begin(); g != csps_->newGuards_.end(); ++g)
+    {
+        if (csps_->guardIndex_.find(g->first) == csps_->guardIndex_.end())
+            continue; // posted unconditionally
+        for (Clasp::LitVec::const_iterator s = g->second.begin(); s != g->second.end(); ++s)
+            generateGuard(g->first, *s);
+    }
 
-    size_t index = 0;
-    for (std::map<unsigned int,std::vector<std::pair<GroundConstraint*,bool> > >::iterator i = optimize.begin(); i != optimize.end(); ++i)
+    if (root)
     {
-        LinExpr expr(generateSum(i->second));
-        rel(*this, LinRel(opts_[index],IRT_EQ,expr), ICL);
+        //if (GecodeSolver::optValues.size()>optimize.size())
+        GecodeSolver::optValues.resize(optimize.size(),Int::Limits::max-1);
+        if (optValues.size()>0)
+            ++optValues.back();
+        opts_ = IntVarArray(*this, optimize.size(), Int::Limits::min, Int::Limits::max);
 
-        ++index;
-    }
 
-    iva_ << opts_;
-    iva_ << x_;
+        size_t index = 0;
+        for (std::map<unsigned int,std::vector<std::pair<GroundConstraint*,bool> > >::iterator i = optimize.begin(); i != optimize.end(); ++i)
+        {
+            LinExpr expr(generateSum(i->second));
+            rel(*this, LinRel(opts_[index],IRT_EQ,expr), ICL);
+
+            ++index;
+        }
+
+        iva_ << opts_;
+    }
+    // branch on the new variables, the old ones already have a brancher
+    for(unsigned int i = oldVar; i < numVar; ++i)
+        iva_ << x_[i];
 
     std::sort(iva_.begin(), iva_.end(), boost::bind(&IntVar::before,_1,_2));
     IntVarArgs::iterator newEnd = std::unique(iva_.begin(), iva_.end(), boost::bind(&IntVar::same,_1,_2));
@@ -1488,14 +1856,16 @@ GecodeSolver::SearchSpace::SearchSpace(GecodeSolver* csps, unsigned int numVar,
     IntVarArgs temp;
     if (iva_.size())
         temp << iva_.slice(0,1,std::distance(iva_.begin(),newEnd));
-    branch(*this, temp, branchVar, branchVal);
+    if (temp.size())
+        branch(*this, temp, branchVar, branchVal);
     iva_ = IntVarArgs();
 }
 
-GecodeSolver::SearchSpace::SearchSpace(bool share, SearchSpace& sp) : Space(share, sp)
+GecodeSolver::SearchSpace::SearchSpace(bool share, SearchSpace& sp) : Space(share, sp), waitress_(0)
 {
     x_.update(*this, share, sp.x_);
     b_.update(*this, share, sp.b_);
+    r_.update(*this, share, sp.r_);
     opts_.update(*this,share,sp.opts_);
 }
 
@@ -1512,8 +1882,33 @@ void GecodeSolver::SearchSpace::constrain(const Space& _b)
 
 bool GecodeSolver::SearchSpace::updateOptValues()
 {
+    if (csps_->aspBound_ != Int::Limits::max)
+    {
+        // clasp only accepts models that are at least as good, the minimize literals unknown to gecode add a non-negative weight
+        IntArgs weights;
+        BoolVarArgs lits;
+        int bound = csps_->aspBound_;
+        for (std::vector<std::pair<Clasp::Literal, int> >::const_iterator i = csps_->aspMinimize_.begin(); i != csps_->aspMinimize_.end(); ++i)
+        {
+            std::map<Clasp::Literal, unsigned int>::const_iterator pos = csps_->litToIndex_.find(i->first);
+            std::map<Clasp::Literal, unsigned int>::const_iterator neg = csps_->litToIndex_.find(~i->first);
+            if (pos != csps_->litToIndex_.end())
+            {
+                weights << i->second;
+                lits << b_[pos->second];
+            }
+            else if (neg != csps_->litToIndex_.end())
+            {
+                weights << -i->second;
+                lits << b_[neg->second];
+                bound -= i->second;
+            }
+        }
+        if (lits.size())
+            linear(*this, weights, lits, IRT_LQ, bound, ICL);
+    }
     if (GecodeSolver::optValues.size()==0)
-        return true;
+        return !failed();
     assert(opts_.size() <= GecodeSolver::optValues.size());
     if (GecodeSolver::optValues.size()>1)
     {
@@ -1637,16 +2032,38 @@ void GecodeSolver::SearchSpace::generateConstraint(const Constraint* c, bool val
     }
 }
 
-void GecodeSolver::SearchSpace::generateConstraint(const Constraint* c, unsigned int boolvar)
+void GecodeSolver::SearchSpace::generateConstraint(const Constraint* c, BoolVar b)
 {
     if (c->isSimple())
     {
-        Gecode::rel(*this, generateLinearRelation(c) == b_[boolvar],ICL);
+        Gecode::rel(*this, generateLinearRelation(c) == b,ICL);
     }
     else
     {
-        Gecode::rel(*this, generateBooleanExpression(c) == b_[boolvar],ICL);
+        Gecode::rel(*this, generateBooleanExpression(c) == b,ICL);
+    }
+}
+
+void GecodeSolver::SearchSpace::generateGuard(Clasp::Literal lit, Clasp::Literal step)
+{
+    BoolVar b(b_[csps_->litToIndex(lit).first]);
+    BoolVar r(r_[csps_->guardIndex_[lit]]);
+    if (step == posLit(0))
+    {
+        // the constraint is used by a rule of all later steps
+        rel(*this, b, BOT_EQV, r, 1, ICL);
+        return;
     }
+    if (csps_->getSolver()->isTrue(step))
+        return; // the step already expired
+    // gecode 3 has no half reification, so e is true iff b and r agree and is implied by the negated step literal
+    BoolVar e(*this, 0, 1);
+    rel(*this, b, BOT_EQV, r, e, ICL);
+    if (csps_->getSolver()->isFalse(step))
+        rel(*this, e, IRT_EQ, 1, ICL);
+    else
+        rel(*this, b_[csps_->litToIndex(step).first], BOT_OR, e, 1, ICL);
+    csps_->guards_.push_back(std::make_pair(lit, step));
 }
 
 Gecode::LinRel GecodeSolver::SearchSpace::generateLinearRelation(const Constraint* c)
@@ -1903,12 +2320,13 @@ void GecodeSolver::SearchSpace::generateGlobalConstraint(LParseGlobalConstraintP
         }
 
         IntVarArgs b(gc.heads_[1].size());
-        IntArgs c(gc.heads_[0].size());
+        IntArgs c(gc.heads_[1].size());
         for (size_t i = 0; i < gc.heads_[1].size(); ++i)
         {
             b[i] = expr(*this, generateLinearExpr(gc.heads_[1][i].a_.get()),ICL);
 
-            assert(gc.heads_[1][i].b_.isInteger());
+            if (!gc.heads_[1][i].b_.isInteger())
+                throw ASPmCSPException("The values of a global cardinality constraint must be integers.");
             c[i] = gc.heads_[1][i].b_.getInteger();
         }
 
@@ -1918,6 +2336,67 @@ void GecodeSolver::SearchSpace::generateGlobalConstraint(LParseGlobalConstraintP
 
         return;
     }
+    if (gc.type_==CUMULATIVE)
+    {
+        IntVarArgs s(gc.heads_[0].size());
+        IntArgs p(gc.heads_[1].size());
+        IntArgs u(gc.heads_[2].size());
+        for (size_t i = 0; i < gc.heads_[0].size(); ++i)
+        {
+            s[i] = expr(*this, generateLinearExpr(gc.heads_[0][i].a_.get()),ICL);
+
+            if (!gc.heads_[1][i].a_->isInteger() || !gc.heads_[2][i].a_->isInteger())
+                throw ASPmCSPException("Durations and resource usages of the cumulative constraint must be integers.");
+            p[i] = gc.heads_[1][i].a_->getInteger();
+            u[i] = gc.heads_[2][i].a_->getInteger();
+        }
+
+        const GroundConstraint* cap = gc.heads_[3][0].a_.get();
+        if (!cap->isInteger())
+            throw ASPmCSPException("The capacity of the cumulative constraint must be an integer.");
+        int c = cap->getInteger();
+        switch(gc.cmp_)
+        {
+        case CSPLit::LEQUAL: break;
+        case CSPLit::LOWER: --c; break;
+        default: throw ASPmCSPException("The capacity of the cumulative constraint can only be bounded with $<= or $<.");
+        }
+
+        iva_ << s;
+        Gecode::cumulative(*this,c,s,p,u,ICL);
+        return;
+    }
+    if (gc.type_==ELEMENT)
+    {
+        IntVarArgs a(gc.heads_[0].size());
+        for (size_t i = 0; i < gc.heads_[0].size(); ++i)
+        {
+            a[i] = expr(*this, generateLinearExpr(gc.heads_[0][i].a_.get()),ICL);
+        }
+
+        IntRelType cmp;
+        switch(gc.cmp_)
+        {
+        case CSPLit::ASSIGN:assert(false);
+        case CSPLit::GREATER:cmp=IRT_GR; break;
+        case CSPLit::LOWER:cmp=IRT_LE; break;
+        case CSPLit::EQUAL:cmp=IRT_EQ; break;
+        case CSPLit::GEQUAL:cmp=IRT_GQ; break;
+        case CSPLit::LEQUAL:cmp=IRT_LQ; break;
+        case CSPLit::INEQUAL:cmp=IRT_NQ; break;
+        default: assert(false);
+        }
+
+        iva_ << a;
+        IntVar index(expr(*this, generateLinearExpr(gc.heads_[1][0].a_.get()),ICL));
+        iva_ << index;
+        IntVar value(*this, Int::Limits::min, Int::Limits::max);
+        Gecode::element(*this,a,index,value,ICL);
+        IntVar temp(expr(*this, generateLinearExpr(gc.heads_[2][0].a_.get()),ICL));
+        iva_ << temp;
+        Gecode::rel(*this,value,cmp,temp,ICL);
+        return;
+    }
     if (gc.type_==MINIMIZE_SET || gc.type_==MINIMIZE)
     {
         IntVarArgs a(gc.heads_[0].size());
@@ -1946,6 +2425,121 @@ void GecodeSolver::SearchSpace::generateGlobalConstraint(LParseGlobalConstraintP
 
 }
 
+namespace
+{
+    IntRelType relType(CSPLit::Type cmp)
+    {
+        switch(cmp)
+        {
+        case CSPLit::GREATER: return IRT_GR;
+        case CSPLit::LOWER:   return IRT_LE;
+        case CSPLit::EQUAL:   return IRT_EQ;
+        case CSPLit::GEQUAL:  return IRT_GQ;
+        case CSPLit::LEQUAL:  return IRT_LQ;
+        case CSPLit::INEQUAL: return IRT_NQ;
+        default: assert(false);
+        }
+        return IRT_EQ;
+    }
+}
+
+void GecodeSolver::SearchSpace::generateGlobalConstraint(LParseGlobalConstraintPrinter::GC& gc, BoolVar holds)
+{
+    // gecode has no reified distinct, count, element or binpacking propagators
+    BoolVarArgs parts;
+    IntVarArgs a(gc.heads_[0].size());
+    for (size_t i = 0; i < gc.heads_[0].size(); ++i)
+    {
+        a[i] = expr(*this, generateLinearExpr(gc.heads_[0][i].a_.get()),ICL);
+    }
+    iva_ << a;
+
+    if (gc.type_==DISTINCT)
+    {
+        for (int i = 0; i < a.size(); ++i)
+            for (int j = i+1; j < a.size(); ++j)
+            {
+                BoolVar p(*this,0,1);
+                rel(*this, a[i], IRT_NQ, a[j], p, ICL);
+                parts << p;
+            }
+    }
+    else if (gc.type_==BINPACK)
+    {
+        // a are the loads of the bins, b the bins of the items and s their sizes
+        IntVarArgs b(gc.heads_[1].size());
+        IntArgs s(gc.heads_[2].size());
+        for (size_t i = 0; i < gc.heads_[1].size(); ++i)
+        {
+            b[i] = expr(*this, generateLinearExpr(gc.heads_[1][i].a_.get()),ICL);
+            if (!gc.heads_[2][i].a_->isInteger())
+                throw ASPmCSPException("Third argument of binpacking constraint must be a list of integers.");
+            s[i] = gc.heads_[2][i].a_->getInteger();
+            BoolVar p(*this,0,1);
+            dom(*this, b[i], 0, a.size()-1, p, ICL);
+            parts << p;
+        }
+        iva_ << b;
+        for (int j = 0; j < a.size(); ++j)
+        {
+            BoolVarArgs in(b.size());
+            for (int i = 0; i < b.size(); ++i)
+            {
+                in[i] = BoolVar(*this,0,1);
+                rel(*this, b[i], IRT_EQ, j, in[i], ICL);
+            }
+            BoolVar p(*this,0,1);
+            linear(*this, s, in, IRT_EQ, a[j], p, ICL);
+            parts << p;
+        }
+    }
+    else if (gc.type_==COUNT || gc.type_==COUNT_UNIQUE)
+    {
+        IntVar unique;
+        if (gc.type_==COUNT_UNIQUE)
+        {
+            unique = expr(*this, generateLinearExpr(&gc.heads_[0][0].b_),ICL);
+            iva_ << unique;
+        }
+        BoolVarArgs eq(a.size());
+        for (int i = 0; i < a.size(); ++i)
+        {
+            eq[i] = BoolVar(*this,0,1);
+            if (gc.type_==COUNT)
+            {
+                assert(gc.heads_[0][i].b_.isInteger());
+                rel(*this, a[i], IRT_EQ, gc.heads_[0][i].b_.getInteger(), eq[i], ICL);
+            }
+            else
+                rel(*this, a[i], IRT_EQ, unique, eq[i], ICL);
+        }
+        IntVar temp(expr(*this, generateLinearExpr(gc.heads_[1][0].a_.get()),ICL));
+        iva_ << temp;
+        BoolVar p(*this,0,1);
+        linear(*this, eq, relType(gc.cmp_), temp, p, ICL);
+        parts << p;
+    }
+    else if (gc.type_==ELEMENT)
+    {
+        // NOTE: the index is restricted to the array even if the constraint does not hold
+        IntVar index(expr(*this, generateLinearExpr(gc.heads_[1][0].a_.get()),ICL));
+        iva_ << index;
+        IntVar value(*this, Int::Limits::min, Int::Limits::max);
+        Gecode::element(*this,a,index,value,ICL);
+        IntVar temp(expr(*this, generateLinearExpr(gc.heads_[2][0].a_.get()),ICL));
+        iva_ << temp;
+        BoolVar p(*this,0,1);
+        rel(*this, value, relType(gc.cmp_), temp, p, ICL);
+        parts << p;
+    }
+    else
+    {
+        // the grounder rejects the other global constraints with bodies
+        assert(false);
+    }
+    rel(*this, BOT_AND, parts, holds, ICL);
+}
+
 
 
 }//namespace
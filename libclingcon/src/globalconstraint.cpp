@@ -2,6 +2,8 @@
 #include <gringo/prgvisitor.h>
 #include <gringo/grounder.h>
 #include <gringo/litdep.h>
+#include <gringo/rule.h>
+#include <gringo/exceptions.h>
 
 namespace Clingcon
 {
@@ -84,6 +86,16 @@ namespace Clingcon
             out << "$maximize";
         }
         else
+        if (type_==CUMULATIVE)
+        {
+            out << "$cumulative";
+        }
+        else
+        if (type_==ELEMENT)
+        {
+            out << "$element";
+        }
+        else
         {
             assert(false && "need to implement debug printing");
         }
@@ -98,9 +110,9 @@ namespace Clingcon
                 out << "]";
             }
             else
-            if (type_==COUNT || type_==COUNT_UNIQUE)
+            if (type_==COUNT || type_==COUNT_UNIQUE || type_==CUMULATIVE || type_==ELEMENT)
             {
-                if (i==1)
+                if (isCmpHead(type_, i))
                 {
                     switch(cmp_)
                     {
@@ -221,6 +233,17 @@ namespace Clingcon
         for (size_t i = 0; i < body_.size(); ++i)
         {
             body_[i].grounded(g);
+            // NOTE: gecode offers no reified cumulative or cardinality propagator
+            //       and optimize statements are no constraints,
+            //       so their bodies may only hold domain-determined literals
+            if (!body_[i].fact() && !isReifiable(type_))
+            {
+                std::ostringstream oss;
+                oss << StrLoc(g, loc()) << ": $cumulative, global cardinality and optimize statements cannot be reified, the body literal ";
+                body_[i].print(g, oss);
+                oss << " is not decided by grounding";
+                throw CSPException(oss.str());
+            }
         }
 
 
@@ -237,7 +260,7 @@ namespace Clingcon
         printer->type(type_);
         for (size_t i = 0; i < heads_.size(); ++i)
         {
-            if ((type_==COUNT || type_==COUNT_UNIQUE)&& i==1)
+            if (isCmpHead(type_, i))
                 printer->beginHead(cmp_);
             else
                 printer->beginHead();
@@ -247,6 +270,18 @@ namespace Clingcon
             printer->addHead(vec);
             printer->endHead();
         }
+        bool reified = false;
+        foreach(Lit &lit, body_) { reified = reified || !lit.fact(); }
+        if (reified)
+        {
+            printer->beginBody();
+            ::Printer *rule = v->output()->printer<Rule::Printer>();
+            foreach(Lit &lit, body_)
+            {
+                if (!lit.fact() || lit.forcePrint())
+                    lit.accept(rule);
+            }
+        }
         printer->end();
     }
 
@@ -20,8 +20,8 @@ namespace Clingcon {
                 Clasp::Constraint::PropResult ClingconPropagator::propagate(const Clasp::Literal& l, uint32& date, Clasp::Solver& )
 		{
 			assert(cspSolver_);
-			cspSolver_->propagateLiteral(l,date);
-			return Clasp::Constraint::PropResult(true, true);
+			// drop the watch of retired constraints
+			return Clasp::Constraint::PropResult(true, cspSolver_->propagateLiteral(l,date));
 		}
 		bool ClingconPropagator::nextSymModel(Clasp::Solver&, bool expand) {
                         return expand && cspSolver_->nextAnswer();
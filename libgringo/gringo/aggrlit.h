@@ -57,7 +57,10 @@ protected:
 	ValVecSet sets_;
 	SubstMap  subst_;
 public:
-	bool groundSwitch;
+	//! the conditionals have to be grounded again for this state
+	bool dirty;
+	//! the state has been visited since the last call to finish
+	bool touched;
 };
 
 class BoundAggrState : public AggrState
@@ -156,27 +159,45 @@ protected:
 
 AggrState* new_clone(const AggrState& state);
 
+/** Index of the states of an aggregate keyed by the values of its global
+  * variables. The conditionals of a state are only grounded if the state is
+  * new or has been marked dirty because of a new instance of one of the
+  * literals in a conditional.
+  */
 class AggrDomain
 {
 	typedef boost::ptr_vector<AggrState> AggrStateVec;
+	typedef std::vector<uint32_t> StateIdVec;
 public:
 	AggrDomain();
 	void init(const VarSet &global);
 	BoolPair state(Grounder *g, AggrLit *lit);
 	void finish();
-	void markNew();
+	//! marks the state with the given global values dirty (if there is one)
+	void markDirty(const ValVec::const_iterator &vals);
+	//! marks all states dirty
+	void markDirty();
+	//! remembers the current states, states created afterwards are removed by rollback
+	void mark();
+	//! removes the states created since the last mark (older states keep their elements)
+	void rollback();
 	bool hasNew() const;
 	AggrState *last() const;
 	uint32_t lastId() const;
+	const VarVec &global() const;
 
 private:
-	AggrStateVec states_; // set of aggrstates
-	ValVecSet    domain_; // vals -> states
-	VarVec       global_; // global variables in the aggregate
+	void markDirty(uint32_t id);
+
+private:
+	AggrStateVec states_;  // set of aggrstates
+	ValVecSet    domain_;  // vals -> states
+	VarVec       global_;  // global variables in the aggregate
+	StateIdVec   touched_; // states visited since the last call to finish
+	uint32_t     mark_;    // number of states at the last mark
 	uint32_t     lastId_;
 	AggrState   *last_;
-	bool         new_;    // wheather there is (possibly) a new match
-	bool         groundSwitch_;
+	bool         new_;     // wheather some state has to be grounded again
 };
 
 class AggrLit;
@@ -247,9 +268,24 @@ public:
 
 	~AggrCond();
 
+private:
+	//! a positive predicate literal whose new instances make states dirty
+	struct Watch
+	{
+		Watch(PredLit *lit);
+		PredLit *lit;
+		//! argument positions of the global variables (empty if not all occur as arguments)
+		VarVec   pos;
+		//! number of atoms in the domain of the literal already looked at
+		uint32_t seen;
+	};
+	typedef std::vector<Watch> WatchVec;
+
 private:
 	void expandSet(Lit *lit, Lit::ExpansionType type);
 	void expandHead(Lit *lit, Lit::ExpansionType type);
+	void initWatches();
+	void markDirty();
 
 private:
 	Style                   style_;
@@ -257,6 +293,7 @@ private:
 	LitPtrVec               lits_;
 	clone_ptr<Instantiator> inst_;
 	VarVec                  headVars_;
+	WatchVec                watches_;
 	AggrLit                *aggr_;
 	mutable tribool         complete_;
 	bool                    head_;
@@ -440,10 +477,10 @@ inline AssignAggrState::~AssignAggrState() { }
 
 /////////////////////////////// AggrDomain ///////////////////////////////
 
-inline void AggrDomain::markNew() { new_ = true; }
 inline bool AggrDomain::hasNew() const { return new_; }
 inline AggrState *AggrDomain::last() const { return last_; }
 inline uint32_t AggrDomain::lastId() const { return lastId_; }
+inline const VarVec &AggrDomain::global() const { return global_; }
 
 /////////////////////////////// AggrLit ///////////////////////////////
 
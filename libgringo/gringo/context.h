@@ -19,14 +19,25 @@
 
 #include <gringo/gringo.h>
 
+/** Variable bindings are stored in one array. Every slot remembers the
+  * context it was written in; slots written in an enclosing context appear
+  * unbound. The first write to a slot in a context saves the old slot on a
+  * trail, which is replayed when the context is popped. Hence, pushing and
+  * popping a context only costs the number of variables bound inside it.
+  */
 class Context
 {
 private:
-	typedef std::vector<int> IntVec;
-	/*! \typedef ContextVec
-	  Provides a list of contexts. Every context is a pair of binders and values.
-	*/
-	typedef std::vector<std::pair<IntVec,ValVec> > ContextVec;
+	struct Slot
+	{
+		Slot() : binder(-1), scope(0) { }
+		Val      val;
+		int      binder;
+		uint32_t scope;
+	};
+	typedef std::vector<Slot> SlotVec;
+	typedef std::vector<std::pair<uint32_t, Slot> > Trail;
+	typedef std::vector<uint32_t> MarkVec;
 public:
 	Context();
 	void reserve(uint32_t vars);
@@ -43,6 +54,10 @@ protected:
 	~Context() { }
 
 private:
-	ContextVec contextStack_;
+	SlotVec slots_;
+	//! old slots overwritten in the current contexts
+	Trail   trail_;
+	//! the size of the trail when each context was pushed
+	MarkVec marks_;
 };
 
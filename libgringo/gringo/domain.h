@@ -27,19 +27,40 @@ public:
 	typedef std::vector<PredInfo> PredInfoVec;
 	typedef std::vector<PredIndex*> PredIndexVec;
 	typedef std::vector<Formula*> GroundableVec;
+	typedef std::vector<Index*> IndexVec;
 public:
 	Domain(uint32_t nameId, uint32_t arity, uint32_t domId);
 	const ValVecSet::Index &find(const ValVec::const_iterator &v) const;
 	bool insert(Grounder *g, const ValVec::const_iterator &v, bool fact = false);
 	uint32_t size() const   { return vals_.size(); }
+	//! number of (possibly duplicate) insertions
+	uint32_t inserts() const { return inserts_; }
 	void external(bool e)   { external_ = e; }
 	bool external() const   { return external_; }
+	//! the table providing the atoms of the domain (or 0)
+	void source(SqlSource *s) { source_ = s; }
+	SqlSource *source() const { return source_; }
 	uint32_t arity() const  { return arity_; }
 	uint32_t nameId() const { return nameId_; }
 	uint32_t domId() const  { return domId_; }
 	bool extend(Grounder *g, PredIndex *idx, uint32_t offset);
 	//! creates a map of all possible values for every variable in the literal
 	void allVals(Grounder *g, const TermPtrVec &terms, VarDomains &varDoms);
+	//! the values of the i-th atom
+	ValVec::const_iterator vals(uint32_t i) const { return vals_.begin() + arity_ * i; }
+	//! number of distinct values at the given argument position
+	uint32_t distinct(uint32_t pos);
+	//! remembers the current atoms, everything added afterwards is undone by rollback
+	void mark();
+	//! removes the atoms added since the last mark from the domain and all indices
+	void rollback();
+	//! has to be called before an index receives the first atom added after the mark
+	void track(Index *idx);
+	//! whether the i-th atom is removed again by rollback
+	bool marked(uint32_t i) const { return marking_ && i >= mark_; }
+private:
+	typedef std::vector<boost::unordered_set<Val> > ValSetVec;
+	typedef std::vector<ValVecSet::Index> FactVec;
 private:
 	uint32_t       nameId_;
 	uint32_t       arity_;
@@ -48,7 +69,18 @@ private:
 	PredInfoVec    index_;
 	PredIndexVec   completeIndex_;
 	uint32_t       new_;
+	uint32_t       inserts_;
+	ValSetVec      distinct_;
+	uint32_t       distinctOffset_;
+	//! number of atoms at the last mark
+	uint32_t       mark_;
+	//! indices that received atoms after the mark
+	IndexVec       tracked_;
+	//! atoms before the mark that became facts after it
+	FactVec        facts_;
+	bool           marking_;
 	bool           external_;
+	SqlSource     *source_;
 public:
 	bool           show;
 	bool           hide;
@@ -22,22 +22,29 @@
 class Func
 {
 	friend class FuncTerm;
+	friend class Storage;
 public:
-	Func(Storage *s, uint32_t name, const ValVec& args);
-	size_t hash() const;
+	typedef boost::iterator_range<const Val*> ArgRng;
+public:
+	Func(uint32_t name, const Val *args, uint32_t size, size_t hash);
+	static size_t hash(uint32_t name, const Val *first, const Val *last);
+	size_t hash() const { return hash_; }
 	bool operator==(const Func& a) const;
+	bool equal(uint32_t name, const Val *first, const Val *last) const;
 	void print(Storage const *sto, std::ostream& out) const;
 	int compare(const Func &b, Storage *s) const;
 	uint32_t name() const { return name_; }
-	const ValVec &args() const { return args_; }
+	ArgRng args() const { return ArgRng(args_, args_ + size_); }
 	int32_t getDepth() const { return depth_; }
 	uint32_t getName() const { return name_; }
-	const ValVec& getArgs() const { return args_; }
+	ArgRng getArgs() const { return args(); }
 
 protected:
-	uint32_t name_;
-	int32_t  depth_;
-	ValVec   args_;
+	uint32_t   name_;
+	int32_t    depth_;
+	uint32_t   size_;
+	const Val *args_;
+	size_t     hash_;
 };
 
 inline size_t hash_value(const Func &f)
@@ -100,9 +100,11 @@ class PredLitRep;
 class PredLitSet;
 class PrgVisitor;
 class Printer;
+class Profile;
 class RelLit;
 class RelLit;
 class Rule;
+class SqlSource;
 class Statement;
 class Storage;
 class Streams;
@@ -61,14 +61,25 @@ private:
 	class LuaImpl;
 	typedef std::deque<Groundable*> GroundableQueue;
 	typedef boost::ptr_vector<Module> ModuleVec;
+	typedef boost::ptr_vector<SqlSource> SqlSourceVec;
 
 public:
 	Grounder(Output *out, bool debug, BodyOrderHeuristicPtr heuristic);
 	void analyze(const std::string &depGraph = "", bool stats = false);
+	//! returns the grounding statistics or 0 if they are disabled
+	Profile *profile() const;
+	//! prints the grounding statistics and optionally writes them to a csv file
+	void printProfile(const std::string &csvFile = "");
 	void addMagic();
 	void ground(Module &module);
+	//! remembers the atoms of all domains and the states of the aggregates in the module
+	void mark(Module &module);
+	//! removes everything added to domains, indices and aggregates since the last mark
+	void rollback(Module &module);
 	void enqueue(Groundable *g);
 	void externalStm(uint32_t nameId, uint32_t arity);
+	//! takes the atoms of the predicate from a table of an sqlite3 database
+	void sqlStm(const Loc &loc, uint32_t nameId, uint32_t arity, uint32_t db, uint32_t table);
 	uint32_t createVar();
 	BodyOrderHeuristic& heuristic() const;
 	Module *createModule();
@@ -89,6 +100,8 @@ private:
 	void setModule(Module *module, bool optimizeEdb);
 
 private:
+	//! declared first so that the statements are destroyed before their tables
+	SqlSourceVec           sources_;
 	ModuleVec              modules_;
 	GroundableQueue        queue_;
 	uint32_t               internal_;
@@ -96,6 +109,7 @@ private:
 	bool                   debug_;
 	std::auto_ptr<LuaImpl> luaImpl_;
 	Stats                  stats_;
+	std::auto_ptr<Profile> profile_;
 	BodyOrderHeuristicPtr  heuristic_;
 	Module                *current_;
 	bool                   optimizeEdb_;
@@ -110,3 +124,4 @@ inline StatementPtrVec &Module::statements() { return statements_; }
 // ========================== Grounder ==========================
 
 inline uint32_t Grounder::aggrUid() { return aggrUids_++; }
+inline Profile *Grounder::profile() const { return profile_.get(); }
@@ -30,6 +30,10 @@ public:
 	virtual void finish() = 0;
 	virtual bool hasNew() const = 0;
 	virtual bool init(Grounder* g);
+	//! called before the index receives the first atom of dom added after its mark
+	virtual void mark(Domain *dom);
+	//! called after dom removed the atoms added since its mark
+	virtual void rollback(Domain *dom);
 	virtual ~Index();
 };
 
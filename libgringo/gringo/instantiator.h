@@ -23,6 +23,13 @@ class Instantiator
 {
 public:
 	typedef boost::function1<bool, Grounder*> GroundedCallback;
+	struct Counters
+	{
+		Counters() : probes(0), matches(0), instances(0) { }
+		uint64_t probes;
+		uint64_t matches;
+		uint64_t instances;
+	};
 private:
 	typedef std::vector<int> BoolVec;
 public:
@@ -34,12 +41,14 @@ public:
 	void finish();
 	bool init(Grounder *g);
 	void callback(const GroundedCallback &grounded);
+	Counters &counters() { return counters_; }
 	~Instantiator();
 private:
 	VarVec           vars_;
 	GroundedCallback grounded_;
 	IndexPtrVec      indices_;
 	BoolVec          new_;
+	Counters         counters_;
 };
    
 inline Instantiator* new_clone(const Instantiator&)
@@ -0,0 +1,95 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <gringo/gringo.h>
+#include <gringo/index.h>
+
+//! Matches several predicate literals at once using a generic join.
+/** The atoms of each literal are stored as sorted tuples over its variables
+  * and variables are bound one at a time by intersecting the candidate values
+  * of all literals containing them. Unlike nested PredIndex lookups, this does
+  * not create intermediate results larger than the output for cyclic bodies
+  * like e(X,Y), e(Y,Z), e(Z,X).
+  */
+class JoinIndex : public Index
+{
+public:
+	typedef std::vector<PredLit*> PredLitVec;
+private:
+	struct Relation
+	{
+		Relation(PredLit *pred);
+		PredLit  *pred;
+		//! variables of the literal ordered by their level in the join
+		VarVec    vars;
+		//! level of each variable in the join
+		VarVec    levels;
+		//! tuples of variable values sorted lexicographically (row major)
+		ValVec    vals;
+		//! position of the atom each tuple stems from
+		VarVec    origin;
+		//! number of atoms of the domain that have already been added
+		uint32_t  extended;
+		//! tuples from atoms below this position are old
+		uint32_t  finished;
+		//! largest position of an atom in the relation
+		uint32_t  newest;
+	};
+	typedef std::vector<Relation> RelationVec;
+	typedef std::pair<uint32_t, uint32_t> Range;
+	typedef std::vector<Range> RangeVec;
+	typedef std::vector<std::pair<uint32_t, uint32_t> > ColumnVec;
+	typedef std::vector<ColumnVec> ColumnVecVec;
+
+public:
+	//! Creates an index for the given literals, all their variables are added to bound.
+	JoinIndex(const PredLitVec &preds, VarSet &bound);
+	//! Computes the literals left after removing all acyclic parts (GYO reduction).
+	static void cyclic(const PredLitVec &preds, const VarSet &bound, PredLitVec &core);
+	Match firstMatch(Grounder *grounder, int binder);
+	Match nextMatch(Grounder *grounder, int binder);
+	void reset();
+	void finish();
+	bool hasNew() const;
+	bool init(Grounder *g);
+	void rollback(Domain *dom);
+	~JoinIndex();
+
+private:
+	void extend(Grounder *g, Relation &rel);
+	void open(uint32_t level);
+	bool seek(Grounder *g, uint32_t level);
+	Match match(Grounder *g, int binder, uint32_t level);
+	Range &range(uint32_t level, uint32_t rel) { return ranges_[level * rels_.size() + rel]; }
+
+private:
+	//! variables in join order, variables bound before come first
+	VarVec       vars_;
+	uint32_t     numBound_;
+	RelationVec  rels_;
+	//! relations (and their column) containing the variable of each level
+	ColumnVecVec columns_;
+	//! range of matching tuples of each relation before binding each level
+	RangeVec     ranges_;
+	VarVec       driver_;
+	VarVec       pos_;
+	VarVec       end_;
+	ValVec       binding_;
+};
+
@@ -69,6 +69,7 @@ protected:
 	typedef std::map<Val, MiniMap, boost::function2<bool, const Val&, const Val &> > PrioMap;
 	typedef boost::unordered_map<std::string, std::vector<LitVec> >                  DisplayMap;
 	typedef std::vector<std::pair<uint32_t, std::string> >                           ShownSymbols;
+	typedef boost::unordered_set<AtomVec>                                            RuleSet;
 public:
 	LparseConverter(bool shiftDisj);
 	void prioLit(int32_t lit, const ValVec &set, bool maximize);
@@ -86,6 +87,13 @@ public:
 	void printBasicRule(uint32_t head, const LitVec &lits);
 	void display(const Val &head, LitVec body, bool show);
 	void prepareSymbolTable();
+	void simplify(bool simplify) { simplify_ = simplify; }
+	bool simplify() const { return simplify_; }
+	bool fact(uint32_t sym) const { return sym < facts_.size() && facts_[sym]; }
+	bool simplifyRule(AtomVec &head, AtomVec &pos, AtomVec &neg, bool choice);
+	SymbolMap const &symbols() const { return symbolMap_; }
+	//! adds a symbol of an earlier run (see Snapshot)
+	void restoreSymbol(Symbol::Repr &repr, uint32_t symbol, bool external);
 	virtual ~LparseConverter();
 
 public:
@@ -101,6 +109,13 @@ public:
 	virtual uint32_t symbol() = 0;
 	virtual void doFinalize() = 0;
 	virtual uint32_t getVolAtom(int vol_window) { (void) vol_window; return 0; }
+	//! returns a fresh atom that can still be defined in later steps (0 if the output is not incremental)
+	virtual uint32_t frozenSymbol() { return 0; }
+	//! releases an atom of frozenSymbol that is not going to be defined anymore
+	virtual void unfreezeSymbol(uint32_t sym) { (void)sym; }
+	//! the next symbol returned by symbol() (zero if the output cannot continue an earlier run)
+	virtual uint32_t nextSymbol() const { return 0; }
+	virtual void nextSymbol(uint32_t next) { (void)next; }
 protected:
 	DisplayMap            atomsHidden_;
 	DisplayMap            atomsShown_;
@@ -113,4 +128,8 @@ protected:
 	SymbolMap             symbolMap_;
 	ShownSymbols          shownSymbols_;
 	NewSymbols            newSymbols_;
+
+	bool                  simplify_;
+	std::vector<bool>     facts_;
+	RuleSet               rules_;
 };
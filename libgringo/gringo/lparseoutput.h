@@ -19,6 +19,7 @@
 
 #include <gringo/gringo.h>
 #include <gringo/lparseconverter.h>
+#include <gringo/writer.h>
 
 class LparseOutput : public LparseConverter
 {
@@ -37,9 +38,11 @@ public:
 	void printExternalTableEntry(const Symbol &symbol);
 	void forgetStep(int) { }
 	uint32_t symbol();
+	uint32_t nextSymbol() const { return symbols_; }
+	void nextSymbol(uint32_t next) { symbols_ = next; }
 private:
-	std::ostream &out_;
-	uint32_t      symbols_;
-	bool          hasExternal_;
+	Writer   out_;
+	uint32_t symbols_;
+	bool     hasExternal_;
 };
 
@@ -19,6 +19,7 @@
 
 #include <gringo/gringo.h>
 #include <gringo/output.h>
+#include <gringo/writer.h>
 
 class DelayedOutput
 {
@@ -49,12 +50,13 @@ public:
 	void setLineCallback(const LineCallback &cb);
 	void endLine();
 	std::ostream &buffer();
-	std::ostream &output();
+	Writer &output();
 
 private:
 	Offset::first_type curLine_;
-	std::ostream      &out_;
-	std::stringstream  buf_;
+	Writer             out_;
+	StringBuffer       buf_;
+	std::ostream       bufStream_;
 	LineVec            lines_;
 	FreeVec            free_;
 };
@@ -34,6 +34,16 @@ private:
 	typedef boost::unordered_map<uint32_t, uint32_t, ValCmp, ValCmp> IndexMap;
 	typedef std::vector<uint32_t> BindSet;
 	typedef std::vector<BindSet> BindSets;
+	//! sizes of the index when the domain passed its mark
+	struct Mark
+	{
+		Mark() : marked(false), sets(0), binds(0) { }
+		bool     marked;
+		uint32_t sets;
+		uint32_t binds;
+		//! older sets that received bindings after the mark
+		VarVec   touched;
+	};
 public:
 	PredIndex(Domain *dom, const TermPtrVec &terms, const VarVec &index, const VarVec &bind);
 	void bind(Grounder *grounder, int binder);
@@ -44,6 +54,8 @@ public:
 	void finish();
 	bool hasNew() const;
 	bool init(Grounder *g);
+	void mark(Domain *dom);
+	void rollback(Domain *dom);
 private:
 	IndexMap                  map_;
 	BindSets                  sets_;
@@ -57,6 +69,7 @@ private:
 	BindSet::reverse_iterator end_;
 	uint32_t                  finished_;
 	uint32_t                  lastExtend_;
-	
+	Mark                      mark_;
+
 };
 
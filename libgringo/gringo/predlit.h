@@ -57,6 +57,14 @@ public:
 	virtual Lit::Score score(Grounder *g, VarSet &bound, PredLit *pred);
 };
 
+//! Estimates the number of matches of a literal using the number of distinct values per argument
+class CostBodyOrderHeuristic : public BodyOrderHeuristic
+{
+public:
+	virtual ~CostBodyOrderHeuristic() {}
+	virtual Lit::Score score(Grounder *g, VarSet &bound, PredLit *pred);
+};
+
 class PredLit : public Lit, public PredLitRep, public Matchable
 {
 	using Lit::sign;
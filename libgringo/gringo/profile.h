@@ -0,0 +1,62 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <gringo/gringo.h>
+
+//! Collects per statement grounding statistics (enabled with --gstats)
+//! Conditions of aggregates and conjunctions get rows of their own,
+//! their time is also included in the statement they belong to.
+class Profile
+{
+public:
+	struct Entry
+	{
+		Entry();
+		void add(const Entry &e);
+		//! Wall time spent grounding the statement (in seconds)
+		double   time;
+		//! How often the statement was taken from the grounding queue
+		uint32_t grounded;
+		//! How often the statement was put into the grounding queue
+		uint32_t enqueued;
+		//! Number of bindings tried (calls to firstMatch/nextMatch)
+		uint64_t probes;
+		//! Number of successful matches
+		uint64_t matches;
+		//! Number of ground instances passed to the output
+		uint64_t instances;
+	};
+	typedef std::map<const Formula*, Entry> EntryMap;
+
+public:
+	//! Returns the current wall time used to measure grounding
+	static double now();
+	void enqueued(const Formula *stm);
+	void grounded(const Formula *stm, Instantiator *inst, double time);
+	//! Moves the entry of a fact that is deleted after grounding into the facts summary
+	void fact(const Formula *stm);
+	//! Prints a report of all statements ordered by time
+	void print(Grounder *g, std::ostream &out) const;
+	//! Writes all statistics in csv format, statements ordered by location
+	void dump(Grounder *g, std::ostream &out) const;
+
+private:
+	EntryMap entries_;
+	Entry    facts_;
+};
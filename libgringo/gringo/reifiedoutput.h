@@ -27,34 +27,33 @@ public:
 	typedef std::vector<size_t> Set;
 
 private:
-	class Node
+	//! stores each distinct sequence once in a flat array, indexed by an open addressing table
+	template <class T>
+	class SeqStore
 	{
 	public:
-		Node(size_t symbol);
-		size_t symbol() const;
-		void visit(size_t visited);
-		uint32_t visited() const;
-		void mark();
-		bool marked() const;
-		void pop();
-		bool popped() const;
-		Node *next();
-		bool root();
-
+		typedef std::vector<T> Seq;
 	public:
-		std::vector<Node*> children;
-
+		SeqStore();
+		//! returns the index of the sequence and whether it was new
+		std::pair<uint32_t, bool> insert(const Seq &seq);
+		uint32_t size() const { return hashes_.size(); }
+	private:
+		bool equal(uint32_t i, const Seq &seq) const;
+		void grow();
 	private:
-		size_t   symbol_;
-		uint32_t visited_;
-		uint32_t finished_;
+		Seq                   elems_;
+		std::vector<size_t>   offsets_;
+		std::vector<size_t>   hashes_;
+		std::vector<uint32_t> table_;
 	};
 
 	typedef std::vector<List> ListVec;
 	typedef std::vector<Set>  SetVec;
-	typedef boost::unordered_map<size_t, Node> Graph;
-	typedef boost::unordered_map<Set, uint32_t> SetMap;
-	typedef boost::unordered_map<List, uint32_t> ListMap;
+	//! positive dependencies (head, body) between symbols, turned into a CSR graph in finalize
+	typedef std::vector<std::pair<uint32_t, uint32_t> > EdgeVec;
+	typedef SeqStore<Set::value_type> SetMap;
+	typedef SeqStore<List::value_type> ListMap;
 	typedef boost::unordered_map<int, List> MiniMap;
 	typedef boost::multi_index::multi_index_container
 	<
@@ -101,7 +100,7 @@ private:
 	SymbolMap     symbols_;
 	ListMap       lists_;
 	SetMap        sets_;
-	Graph         graph_;
+	EdgeVec       edges_;
 	MiniMap       minimize_;
 	ListVec       listStack_;
 	SetVec        setStack_;
@@ -0,0 +1,38 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <gringo/gringo.h>
+
+//! Saves and restores the grounded atoms of a program (--save-state/--load-state)
+/**
+ * A snapshot holds the strings and function terms of the storage, the atoms
+ * of all domains with their fact flags, the output symbols of an lparse
+ * converter, and the last grounded incremental step. The file consists of
+ * little endian 32 bit words (strings are padded), so it can also be mapped.
+ * Indices of strings, function terms and domains are remapped while
+ * loading, so the program may have been parsed already.
+ */
+class Snapshot
+{
+public:
+	static void save(std::ostream &out, Grounder *g, LparseConverter *conv, int step);
+	//! returns the last grounded step of the snapshot
+	static int load(std::istream &in, Grounder *g, LparseConverter *conv);
+};
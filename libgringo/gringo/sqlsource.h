@@ -0,0 +1,57 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <gringo/gringo.h>
+#include <gringo/locateable.h>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+//! Provides the atoms of a predicate from an sqlite3 table (see #sql)
+/**
+ * Body literals over the predicate query the table instead of the domain.
+ * Arguments that are bound when the literal is matched are passed as
+ * parameters of a prepared statement; rows are decoded directly into
+ * values (integers become numbers, text becomes strings, rows with nulls
+ * are skipped) and added to the domain as facts.
+ */
+class SqlSource
+{
+public:
+	class Query;
+public:
+	SqlSource(Grounder *g, const Loc &loc, const std::string &db, const std::string &table, uint32_t arity);
+	//! creates an index for a literal binding the variables in bind
+	Index *index(Grounder *g, PredLit *pred, const VarVec &bind);
+	//! adds the atom to the domain if it is in the table
+	void fetch(Grounder *g, Domain *dom, const ValVec::const_iterator &vals);
+	~SqlSource();
+private:
+	friend class Query;
+	sqlite3_stmt *prepare(const std::vector<bool> &pushed);
+	void error(const std::string &msg);
+private:
+	Loc                      loc_;
+	Storage                 *storage_;
+	sqlite3                 *db_;
+	std::string              table_;
+	StringVec                columns_;
+	std::auto_ptr<Query>     fetch_;
+};
@@ -33,22 +33,24 @@ private:
 			boost::multi_index::hashed_unique<boost::multi_index::identity<std::string> >
 		>
 	> StringSet;
-	typedef boost::multi_index::multi_index_container
-	<
-		Func, boost::multi_index::indexed_by
-		<
-			boost::multi_index::random_access<>,
-			boost::multi_index::hashed_unique<boost::multi_index::identity<Func> >
-		>
-	> FuncSet;
+	typedef std::vector<Func> FuncVec;
+	//! open addressing table of function term indices (shifted by one, zero marks empty slots)
+	typedef std::vector<uint32_t> FuncTable;
+	//! arguments of function terms are stored in blocks that are never reallocated
+	typedef boost::ptr_vector<ValVec> ArgBlocks;
+	enum { ARG_BLOCK_SIZE = 4096 };
 public:
 	std::string quote(const std::string &str) const;
 	std::string unquote(const std::string &str) const;
 	Storage(Output *output);
 	uint32_t index(const Func &f);
+	uint32_t index(uint32_t name, const ValVec &args);
+	uint32_t index(uint32_t name, const Val *first, const Val *last);
 	const Func &func(uint32_t i) const;
 	uint32_t index(const std::string &s);
 	const std::string &string(uint32_t i) const;
+	uint32_t numStrings() const { return strings_.size(); }
+	uint32_t numFuncs() const { return funcs_.size(); }
 	Domain *domain(uint32_t domId);
 	Domain const *domain(uint32_t domId) const;
 	Domain *newDomain(uint32_t nameId, uint32_t arity);
@@ -56,9 +58,14 @@ public:
 	DomainVec const &domains() const { return domains_; }
 	Output *output() const { return output_; }
 	~Storage();
+private:
+	const Val *storeArgs(const Val *first, const Val *last);
+	void growFuncTable();
 private:
 	StringSet strings_;
-	FuncSet   funcs_;
+	FuncVec   funcs_;
+	FuncTable funcTable_;
+	ArgBlocks argBlocks_;
 	DomainMap doms_;
 	DomainVec domains_;
 	Output   *output_;
@@ -41,6 +41,8 @@ public:
 	const Index &find(const const_iterator &v) const;
 	InsertRes insert(const const_iterator &v, bool fact = false);
 	void extend(const ValVecSet &other);
+	//! removes the most recently inserted value vectors until size elements are left
+	void truncate(uint32_t size);
 
 private:
 	uint32_t       arity_;
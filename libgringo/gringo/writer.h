@@ -0,0 +1,123 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <gringo/gringo.h>
+#include <streambuf>
+#include <cstring>
+
+//! Buffered text output that formats integers itself instead of going through the stream's locale
+class Writer
+{
+public:
+	enum { BUFFER_SIZE = 1 << 16, MAX_DIGITS = 24 };
+public:
+	Writer(std::ostream &out);
+	Writer &operator<<(char c);
+	Writer &operator<<(const char *str);
+	Writer &operator<<(const std::string &str);
+	Writer &operator<<(int32_t num);
+	Writer &operator<<(uint32_t num);
+	Writer &operator<<(int64_t num);
+	Writer &operator<<(uint64_t num);
+	void write(const char *str, size_t size);
+	//! passes the buffered text to the stream in one block
+	void flush();
+	std::ostream &stream() { return out_; }
+	//! writes the digits of num right-aligned before end and returns a pointer to the first character
+	static char *format(char *end, uint64_t num);
+	static char *format(char *end, int64_t num);
+	~Writer();
+private:
+	std::ostream     &out_;
+	std::vector<char> buf_;
+	size_t            size_;
+};
+
+//! Collects stream output in a string that can be taken without copying
+class StringBuffer : public std::streambuf
+{
+public:
+	const std::string &str() const { return str_; }
+	void take(std::string &str) { str_.swap(str); str_.clear(); }
+	void clear() { str_.clear(); }
+protected:
+	int_type overflow(int_type c);
+	std::streamsize xsputn(const char *s, std::streamsize n);
+private:
+	std::string str_;
+};
+
+inline void Writer::write(const char *str, size_t size)
+{
+	if(size_ + size > buf_.size())
+	{
+		flush();
+		if(size > buf_.size()) { out_.write(str, size); return; }
+	}
+	std::memcpy(&buf_[size_], str, size);
+	size_ += size;
+}
+
+inline Writer &Writer::operator<<(char c)
+{
+	if(size_ == buf_.size()) { flush(); }
+	buf_[size_++] = c;
+	return *this;
+}
+
+inline Writer &Writer::operator<<(const char *str)          { write(str, std::strlen(str)); return *this; }
+inline Writer &Writer::operator<<(const std::string &str)   { write(str.data(), str.size()); return *this; }
+inline Writer &Writer::operator<<(int32_t num)              { return *this << static_cast<int64_t>(num); }
+inline Writer &Writer::operator<<(uint32_t num)             { return *this << static_cast<uint64_t>(num); }
+
+inline Writer &Writer::operator<<(int64_t num)
+{
+	char buf[MAX_DIGITS];
+	char *first = format(buf + MAX_DIGITS, num);
+	write(first, buf + MAX_DIGITS - first);
+	return *this;
+}
+
+inline Writer &Writer::operator<<(uint64_t num)
+{
+	char buf[MAX_DIGITS];
+	char *first = format(buf + MAX_DIGITS, num);
+	write(first, buf + MAX_DIGITS - first);
+	return *this;
+}
+
+inline char *Writer::format(char *end, uint64_t num)
+{
+	do
+	{
+		*--end = static_cast<char>('0' + num % 10);
+		num /= 10;
+	}
+	while(num != 0);
+	return end;
+}
+
+inline char *Writer::format(char *end, int64_t num)
+{
+	// NOTE: negating as unsigned also works for the smallest number
+	if(num >= 0) { return format(end, static_cast<uint64_t>(num)); }
+	end = format(end, ~static_cast<uint64_t>(num) + 1);
+	*--end = '-';
+	return end;
+}
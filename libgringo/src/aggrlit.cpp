@@ -28,6 +28,7 @@
 #include <gringo/domain.h>
 #include <gringo/index.h>
 #include <gringo/output.h>
+#include <gringo/profile.h>
 
 namespace
 {
@@ -101,7 +102,8 @@ namespace
 //////////////////////////////////////// AggrState ////////////////////////////////////////
 
 AggrState::AggrState()
-	: groundSwitch(true)
+	: dirty(false)
+	, touched(false)
 { }
 
 void AggrState::accumulate(Grounder *g, Lit *head, const VarVec &headVars, AggrLit &lit, const ValVec &set, bool fact)
@@ -194,9 +196,9 @@ void BoundAggrState::checkBounds(Grounder *g, AggrLit &lit, const Val64 &min, co
 
 AggrDomain::AggrDomain()
 	: domain_(0)
+	, mark_(0)
 	, last_(0)
 	, new_(false)
-	, groundSwitch_(true)
 {
 }
 
@@ -219,27 +221,61 @@ BoolPair AggrDomain::state(Grounder *g, AggrLit *lit)
 	if(res.get<1>()) { states_.push_back(lit->newAggrState(g)); }
 	lastId_ = vals.size() ? res.get<0>() / vals.size() : 0;
 	last_   = &states_[lastId_];
-	if(res.get<1>())
+	if(!last_->touched)
 	{
-		last_->groundSwitch = !groundSwitch_;
-		return BoolPair(true, true);
+		last_->touched = true;
+		touched_.push_back(lastId_);
 	}
-	else
+	// NOTE: the conditionals of old states only have to be grounded
+	//       if there are new instances for their global variables
+	bool ground = res.get<1>() || last_->dirty;
+	last_->dirty = false;
+	return BoolPair(res.get<1>(), ground);
+}
+
+void AggrDomain::markDirty(uint32_t id)
+{
+	if(!states_[id].dirty)
 	{
-		bool oldSwitch = last_->groundSwitch;
-		last_->groundSwitch = !groundSwitch_;
-		return BoolPair(false, oldSwitch == groundSwitch_);
+		states_[id].dirty = true;
+		new_              = true;
 	}
 }
 
+void AggrDomain::markDirty(const ValVec::const_iterator &vals)
+{
+	if(states_.empty()) { return; }
+	const ValVecSet::Index &idx = domain_.find(vals);
+	if(idx.valid()) { markDirty(global_.size() ? idx / global_.size() : 0); }
+}
+
+void AggrDomain::markDirty()
+{
+	for(uint32_t id = 0; id < states_.size(); id++) { markDirty(id); }
+}
+
+void AggrDomain::mark()
+{
+	mark_ = states_.size();
+}
+
+void AggrDomain::rollback()
+{
+	if(states_.size() == mark_) { return; }
+	states_.erase(states_.begin() + mark_, states_.end());
+	domain_.truncate(mark_);
+	touched_.erase(std::remove_if(touched_.begin(), touched_.end(), boost::bind(std::greater_equal<uint32_t>(), _1, mark_)), touched_.end());
+	last_ = 0;
+}
+
 void AggrDomain::finish()
 {
-	groundSwitch_ = !groundSwitch_;
-	foreach(AggrState &state, states_)
+	foreach(uint32_t id, touched_)
 	{
-		state.finish();
-		state.groundSwitch = groundSwitch_;
+		states_[id].finish();
+		states_[id].touched = false;
 	}
+	touched_.clear();
 	new_ = false;
 }
 
@@ -297,7 +333,6 @@ void AggrLit::addDomain(Grounder *g, bool)
 
 void AggrLit::enqueue(Grounder *g)
 {
-	domain().markNew();
 	parent_->enqueue(g);
 }
 
@@ -458,7 +493,67 @@ void AggrCond::head(bool head)
 
 void AggrCond::enqueue(Grounder *g)
 {
-	aggr_->enqueue(g);
+	markDirty();
+	if(aggr_->domain().hasNew()) { aggr_->enqueue(g); }
+}
+
+void AggrCond::initWatches()
+{
+	watches_.clear();
+	const VarVec &global = aggr_->domain().global();
+	for(LitPtrVec::iterator it = lits_.begin() + head_; it != lits_.end(); it++)
+	{
+		PredLit *pred = dynamic_cast<PredLit*>(&*it);
+		if(!pred || pred->head() || pred->sign() || pred->dom()->external()) { continue; }
+		watches_.push_back(Watch(pred));
+		VarVec &pos = watches_.back().pos;
+		foreach(uint32_t var, global)
+		{
+			uint32_t i = 0;
+			for(; i < pred->terms().size(); i++)
+			{
+				const VarTerm *term = dynamic_cast<const VarTerm*>(&pred->terms()[i]);
+				if(term && term->index() == var) { break; }
+			}
+			// NOTE: the literal does not determine the state
+			//       so each of its new instances makes all states dirty
+			if(i == pred->terms().size())
+			{
+				pos.clear();
+				break;
+			}
+			pos.push_back(i);
+		}
+	}
+}
+
+void AggrCond::markDirty()
+{
+	AggrDomain &domain = aggr_->domain();
+	ValVec vals(domain.global().size());
+	foreach(Watch &watch, watches_)
+	{
+		Domain  *dom  = watch.lit->dom();
+		uint32_t size = dom->size();
+		// NOTE: the domain might have been rolled back
+		if(watch.seen >= size)
+		{
+			watch.seen = size;
+			continue;
+		}
+		if(watch.pos.size() != vals.size()) { domain.markDirty(); }
+		else
+		{
+			// a new atom can only change the state its global variables are bound to
+			for(; watch.seen < size; watch.seen++)
+			{
+				ValVec::const_iterator atom = dom->vals(watch.seen);
+				for(uint32_t i = 0; i < vals.size(); i++) { vals[i] = *(atom + watch.pos[i]); }
+				domain.markDirty(vals.begin());
+			}
+		}
+		watch.seen = size;
+	}
 }
 
 bool AggrCond::complete() const
@@ -546,6 +641,7 @@ void AggrCond::initInst(Grounder *g)
 	{
 		inst_.reset(new Instantiator(vars(), boost::bind(&AggrCond::grounded, this, _1)));
 		simpleInitInst(g, *inst_);
+		initWatches();
 	}
 	if(inst_->init(g)) { enqueue(g); }
 }
@@ -557,7 +653,9 @@ void AggrCond::finish()
 
 void AggrCond::ground(Grounder *g)
 {
+	double start = g->profile() ? Profile::now() : 0;
 	inst_->ground(g);
+	if(g->profile()) { g->profile()->grounded(this, inst_.get(), Profile::now() - start); }
 }
 
 void AggrCond::visit(PrgVisitor *visitor)
@@ -656,6 +754,14 @@ AggrCond::~AggrCond()
 {
 }
 
+//////////////////////////////////////// AggrCond::Watch ////////////////////////////////////////
+
+AggrCond::Watch::Watch(PredLit *lit)
+	: lit(lit)
+	, seen(0)
+{
+}
+
 AggrCond* new_clone(const AggrCond& a)
 {
 	return new AggrCond(a);
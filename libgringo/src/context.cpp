@@ -19,50 +19,54 @@
 
 Context::Context()
 {
-	contextStack_.push_back(ContextVec::value_type());
 }
 
 void Context::reserve(uint32_t vars)
 {
-	if(contextStack_.back().first.size() < vars)
-	{
-		contextStack_.back().first.resize(vars, -1);
-		contextStack_.back().second.resize(vars);
-	}
+	if(slots_.size() < vars) { slots_.resize(vars); }
 }
 
 const Val &Context::val(uint32_t index) const
 {
-	assert(contextStack_.back().first[index] != -1);
-	return contextStack_.back().second[index];
+	assert(binder(index) != -1);
+	return slots_[index].val;
 }
 
 void Context::val(uint32_t index, const Val &v, int binder)
 {
-	contextStack_.back().first[index] = binder;
-	contextStack_.back().second[index] = v;
+	Slot &slot = slots_[index];
+	if(slot.scope != marks_.size())
+	{
+		trail_.push_back(std::make_pair(index, slot));
+		slot.scope = marks_.size();
+	}
+	slot.binder = binder;
+	slot.val    = v;
 }
 
 int Context::binder(uint32_t index) const
 {
-	assert(index < contextStack_.back().first.size());
-	return contextStack_.back().first[index];
+	assert(index < slots_.size());
+	const Slot &slot = slots_[index];
+	return slot.scope == marks_.size() ? slot.binder : -1;
 }
 
 void Context::unbind(uint32_t index)
 {
-	contextStack_.back().first[index] = -1;
+	Slot &slot = slots_[index];
+	// slots of enclosing contexts are unbound anyway
+	if(slot.scope == marks_.size()) { slot.binder = -1; }
 }
 
 void Context::pushContext()
 {
-	contextStack_.push_back(ContextVec::value_type(contextStack_.back().first, contextStack_.back().second));
-	for(size_t i = 0; i < contextStack_.back().first.size(); i++) { this->unbind(i); }
+	marks_.push_back(trail_.size());
 }
 
 void Context::popContext()
 {
-	assert(contextStack_.size() > 0);
-	contextStack_.pop_back();
+	assert(marks_.size() > 0);
+	for(size_t i = trail_.size(); i-- > marks_.back(); ) { slots_[trail_[i].first] = trail_[i].second; }
+	trail_.resize(marks_.back());
+	marks_.pop_back();
 }
-
@@ -18,6 +18,7 @@
 #include <gringo/domain.h>
 #include <gringo/val.h>
 #include <gringo/predindex.h>
+#include <gringo/index.h>
 #include <gringo/predlit.h>
 #include <gringo/term.h>
 #include <gringo/grounder.h>
@@ -32,7 +33,12 @@ Domain::Domain(uint32_t nameId, uint32_t arity, uint32_t domId)
 	, domId_(domId)
 	, vals_(arity)
 	, new_(0)
+	, inserts_(0)
+	, distinctOffset_(0)
+	, mark_(0)
+	, marking_(false)
 	, external_(false)
+	, source_(0)
 	, show(false)
 	, hide(false)
 {
@@ -45,6 +51,12 @@ const ValVecSet::Index &Domain::find(const ValVec::const_iterator &v) const
 
 bool Domain::insert(Grounder *, const ValVec::const_iterator &v, bool fact)
 {
+	inserts_++;
+	if(marking_ && fact)
+	{
+		const ValVecSet::Index &idx = vals_.find(v);
+		if(idx.valid() && !idx.fact) { facts_.push_back(idx); }
+	}
 	ValVecSet::InsertRes res = vals_.insert(v, fact);
 	return res.get<1>();
 }
@@ -55,11 +67,55 @@ bool Domain::extend(Grounder *g, PredIndex *idx, uint32_t offset)
 	ValVec::const_iterator k = vals_.begin() + arity_ * offset;
 	for(uint32_t i = offset; i < size(); i++, k+= arity_)
 	{
+		if(i == std::max(offset, mark_) && marking_) { track(idx); }
 		modified = idx->extend(g, k) || modified;
 	}
 	return modified;
 }
 
+void Domain::mark()
+{
+	assert(!marking_);
+	mark_    = size();
+	marking_ = true;
+}
+
+void Domain::track(Index *idx)
+{
+	if(std::find(tracked_.begin(), tracked_.end(), idx) == tracked_.end())
+	{
+		idx->mark(this);
+		tracked_.push_back(idx);
+	}
+}
+
+void Domain::rollback()
+{
+	assert(marking_);
+	marking_ = false;
+	ValVec vals;
+	foreach(const ValVecSet::Index &idx, facts_)
+	{
+		if((arity_ ? idx.index / arity_ : 0) < mark_)
+		{
+			vals.assign(vals_.begin() + idx.index, vals_.begin() + idx.index + arity_);
+			vals_.find(vals.begin()).fact = false;
+		}
+	}
+	if(size() > mark_)
+	{
+		vals_.truncate(mark_);
+		if(distinctOffset_ > mark_)
+		{
+			distinct_.clear();
+			distinctOffset_ = 0;
+		}
+	}
+	foreach(Index *idx, tracked_) { idx->rollback(this); }
+	tracked_.clear();
+	facts_.clear();
+}
+
 void Domain::allVals(Grounder *g, const TermPtrVec &terms, VarDomains &varDoms)
 {
 	VarSet vars;
@@ -84,3 +140,18 @@ void Domain::allVals(Grounder *g, const TermPtrVec &terms, VarDomains &varDoms)
 	}
 	varDoms.offset = size();
 }
+
+uint32_t Domain::distinct(uint32_t pos)
+{
+	assert(pos < arity_);
+	// the sets are only created for domains used by the cost heuristic and are
+	// updated with the values inserted since the last call
+	distinct_.resize(arity_);
+	ValVec::const_iterator k = vals_.begin() + arity_ * distinctOffset_;
+	for(uint32_t i = distinctOffset_; i < size(); i++)
+	{
+		foreach(boost::unordered_set<Val> &set, distinct_) { set.insert(*k++); }
+	}
+	distinctOffset_ = size();
+	return distinct_[pos].size();
+}
@@ -23,6 +23,10 @@
 #include <gringo/exceptions.h>
 #include <gringo/instantiator.h>
 #include <gringo/grounder.h>
+#include <gringo/profile.h>
+#include <gringo/joinindex.h>
+#include <gringo/predlit.h>
+#include <gringo/domain.h>
 
 namespace
 {
@@ -36,10 +40,22 @@ namespace
 		static void add(Grounder *g, Formula *f, Instantiator &inst);
 
 	private:
-		Grounder     *g_;
-		Formula      *f_;
-		Instantiator &inst_;
-		VarSet        bound_;
+		Grounder              *g_;
+		Formula               *f_;
+		Instantiator          &inst_;
+		VarSet                 bound_;
+		JoinIndex::PredLitVec  join_;
+		bool                   joined_;
+	};
+
+	//! collects the literals that can be matched by a JoinIndex
+	class JoinCollector : public PrgVisitor
+	{
+	public:
+		JoinCollector(JoinIndex::PredLitVec &preds) : preds_(preds) { }
+		void visit(Lit *lit, bool domain);
+	private:
+		JoinIndex::PredLitVec &preds_;
 	};
 
 	class VarCollector : public PrgVisitor
@@ -144,6 +160,7 @@ void SimpleStatement::enqueue(Grounder *g)
 	if(!enqueued_)
 	{
 		enqueued_ = true;
+		if(g->profile()) { g->profile()->enqueued(this); }
 		g->enqueue(this);
 	}
 }
@@ -151,6 +168,7 @@ void SimpleStatement::enqueue(Grounder *g)
 void SimpleStatement::ground(Grounder *g)
 {
 	enqueued_ = false;
+	double start = g->profile() ? Profile::now() : 0;
 	if(inst_.get())
 	{
 		inst_->ground(g);
@@ -162,6 +180,7 @@ void SimpleStatement::ground(Grounder *g)
 		grounded(g);
 	}
 	endGround(g);
+	if(g->profile()) { g->profile()->grounded(this, inst_.get(), Profile::now() - start); }
 }
 
 SimpleStatement::~SimpleStatement()
@@ -174,10 +193,21 @@ IndexAdder::IndexAdder(Grounder *g, Formula *f, Instantiator &inst)
 	: g_(g)
 	, f_(f)
 	, inst_(inst)
+	, joined_(false)
 { }
 
 void IndexAdder::visit(Lit *lit, bool)
 {
+	foreach(PredLit *pred, join_)
+	{
+		if(static_cast<Lit*>(pred) == lit)
+		{
+			// the whole cyclic part is matched at the position of its first literal
+			if(!joined_) { inst_.append(new JoinIndex(join_, bound_)); }
+			joined_ = true;
+			return;
+		}
+	}
 	inst_.append(lit->index(g_, f_, bound_));
 }
 
@@ -186,10 +216,32 @@ void IndexAdder::add(Grounder *g, Formula *f, Instantiator &inst)
 	IndexAdder adder(g, f, inst);
 	// TODO: think about putting local/global vars in formula!
 	if(f->level() > 0) { GlobalsCollector::collect(*f, adder.bound_, f->level() - 1); }
+	else
+	{
+		// cyclic joins like e(X,Y), e(Y,Z), e(Z,X) are better matched all at once
+		JoinIndex::PredLitVec preds;
+		JoinCollector collector(preds);
+		f->visit(&collector);
+		JoinIndex::cyclic(preds, adder.bound_, adder.join_);
+	}
 	if(f->litDep()) { f->litDep()->order(g, boost::bind(&IndexAdder::visit, &adder, _1, false), adder.bound_); }
 	else { f->visit(&adder); }
 }
 
+//////////////////////////////// JoinCollector ////////////////////////////////
+
+void JoinCollector::visit(Lit *lit, bool)
+{
+	PredLit *pred = dynamic_cast<PredLit*>(lit);
+	// only positive literals over complete domains whose arguments are variables or constants
+	if(!pred || pred->head() || pred->sign() || !pred->complete() || pred->dom()->external() || pred->dom()->source()) { return; }
+	foreach(const Term &term, pred->terms())
+	{
+		if(!dynamic_cast<const VarTerm*>(&term) && !term.constant()) { return; }
+	}
+	preds_.push_back(pred);
+}
+
 //////////////////////////////// VarCollector ////////////////////////////////
 
 VarCollector::VarCollector(Grounder *grounder)
@@ -18,53 +18,41 @@
 #include <gringo/func.h>
 #include <gringo/storage.h>
 
-namespace
-{
-	int32_t termDepth(Storage *s, const ValVec& args)
-	{
-		int32_t maxDepth = 1;
-		foreach(const Val &val, args)
-		{
-			if (val.type == Val::FUNC)
-			{
-				int32_t depth = s->func(val.index).getDepth();
-				if (depth >= maxDepth) { maxDepth = depth + 1; }
-			}
-		}
-		return maxDepth;
-	}
-}
-
-Func::Func(Storage *s, uint32_t name, const ValVec& args)
+Func::Func(uint32_t name, const Val *args, uint32_t size, size_t hash)
 	: name_(name)
-	, depth_(termDepth(s, args))
+	, depth_(1)
+	, size_(size)
 	, args_(args)
+	, hash_(hash)
 {
 }
 
-size_t Func::hash() const
+size_t Func::hash(uint32_t name, const Val *first, const Val *last)
 {
-	size_t seed = name_;
-	boost::hash_range(seed, args_.begin(), args_.end());
+	size_t seed = name;
+	boost::hash_range(seed, first, last);
 	return seed;
 }
 
 bool Func::operator==(const Func& a) const
 {
-	if(name_ != a.name_) return false;
-	if(args_.size() != a.args_.size()) return false;
-	for(ValVec::size_type i = 0; i < args_.size(); i++)
-		if(!(args_[i] == a.args_[i])) return false;
-	return true;
+	return hash_ == a.hash_ && equal(a.name_, a.args_, a.args_ + a.size_);
+}
+
+bool Func::equal(uint32_t name, const Val *first, const Val *last) const
+{
+	if(name_ != name) return false;
+	if(size_ != uint32_t(last - first)) return false;
+	return std::equal(first, last, args_);
 }
 
 int Func::compare(const Func &b, Storage *s) const
 {
-    if(args_.size() != b.args_.size())
-        return int(b.args_.size()) - args_.size();
+    if(size_ != b.size_)
+        return int(b.size_) - int(size_);
     if(name_ != b.name_)
         return s->string(name_).compare(s->string(b.name_));
-    for(ValVec::size_type i = 0; i < args_.size(); i++)
+    for(uint32_t i = 0; i < size_; i++)
     {
        int cmp = args_[i].compare(b.args_[i], s);
        if(cmp != 0)
@@ -79,7 +67,7 @@ void Func::print(Storage const *sto, std::ostream& out) const
 	out << sto->string(name_);
 	out << "(";
 	bool comma = false;
-	foreach(const Val &val, args_)
+	foreach(const Val &val, args())
 	{
 		if(comma) out << ",";
 		else comma = true;
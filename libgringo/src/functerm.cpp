@@ -30,9 +30,17 @@ FuncTerm::FuncTerm(const Loc &loc, uint32_t name, TermPtrVec &args)
 
 Val FuncTerm::val(Grounder *grounder) const
 {
-	ValVec vals;
-	foreach(const Term &term, args_) vals.push_back(term.val(grounder));
-	return Val::func(grounder->index(Func(grounder, name_, vals)));
+	// small argument lists are evaluated on the stack
+	Val small[8];
+	ValVec large;
+	Val *vals = small;
+	if(args_.size() > sizeof(small) / sizeof(Val))
+	{
+		large.resize(args_.size());
+		vals = &large[0];
+	}
+	for(TermPtrVec::size_type i = 0; i < args_.size(); i++) { vals[i] = args_[i].val(grounder); }
+	return Val::func(grounder->index(name_, vals, vals + args_.size()));
 }
 
 void FuncTerm::normalize(Lit *parent, const Ref &ref, Grounder *g, const Expander &e, bool unify)
@@ -60,11 +68,18 @@ AbsTerm::Ref* FuncTerm::abstract(Substitution& subst) const
 bool FuncTerm::unify(Grounder *grounder, const Val &v, int binder) const
 {
 	if(v.type != Val::FUNC) return false;
-	const Func &f = grounder->func(v.index);
-	if(name_ != f.name_) return false;
-	if(args_.size() != f.args_.size()) return false;
+	// NOTE: unifying the arguments may store new function terms and
+	//       reallocate the function table, so no reference into it is kept;
+	//       the argument blocks themselves are never reallocated
+	Func::ArgRng args;
+	{
+		const Func &f = grounder->func(v.index);
+		if(name_ != f.name_) return false;
+		if(args_.size() != f.size_) return false;
+		args = f.args();
+	}
 	for(TermPtrVec::size_type i = 0; i < args_.size(); i++)
-		if(!args_[i].unify(grounder, f.args_[i], binder)) return false;
+		if(!args_[i].unify(grounder, args[i], binder)) return false;
 	return true;
 }
 
@@ -27,6 +27,10 @@
 #include <gringo/luaterm.h>
 #include <gringo/inclit.h>
 #include <gringo/predlit.h>
+#include <gringo/aggrlit.h>
+#include <gringo/prgvisitor.h>
+#include <gringo/profile.h>
+#include <gringo/sqlsource.h>
 
 // ========================== LuaImpl ==========================
 
@@ -47,6 +51,26 @@ public:
 
 #endif
 
+// ========================== AggrMarker ==========================
+
+namespace
+{
+	class AggrMarker : public PrgVisitor
+	{
+	public:
+		AggrMarker(bool mark) : mark_(mark) { }
+		void visit(Lit *lit, bool)
+		{
+			AggrLit *aggr = dynamic_cast<AggrLit*>(lit);
+			if(!aggr)      { return; }
+			else if(mark_) { aggr->domain().mark(); }
+			else           { aggr->domain().rollback(); }
+		}
+	private:
+		bool mark_;
+	};
+}
+
 // ========================== Module ==========================
 
 StatementRng Module::add(Grounder *g, Statement *s, bool optimizeEdb)
@@ -169,6 +193,18 @@ void Grounder::analyze(const std::string &depGraph, bool stats)
 		}
 		stats_.avgPredParams = (stats_.numPred == 0) ? 0 : paramCount*1.0 / stats_.numPred;
 		stats_.print(std::cerr);
+		profile_.reset(new Profile());
+	}
+}
+
+void Grounder::printProfile(const std::string &csvFile)
+{
+	if(!profile_.get()) { return; }
+	profile_->print(this, std::cerr);
+	if(!csvFile.empty())
+	{
+		std::ofstream out(csvFile.c_str());
+		profile_->dump(this, out);
 	}
 }
 
@@ -196,6 +232,20 @@ void Grounder::ground(Module &module)
 	}
 }
 
+void Grounder::mark(Module &module)
+{
+	foreach(Domain *dom, domains()) { dom->mark(); }
+	AggrMarker marker(true);
+	foreach(Statement &statement, module.statements()) { statement.visit(&marker); }
+}
+
+void Grounder::rollback(Module &module)
+{
+	foreach(Domain *dom, domains()) { dom->rollback(); }
+	AggrMarker marker(false);
+	foreach(Statement &statement, module.statements()) { statement.visit(&marker); }
+}
+
 void Grounder::ground_()
 {
 	while(!queue_.empty())
@@ -225,6 +275,19 @@ void Grounder::externalStm(uint32_t nameId, uint32_t arity)
 	newDomain(nameId, arity)->external(true);
 }
 
+void Grounder::sqlStm(const Loc &loc, uint32_t nameId, uint32_t arity, uint32_t db, uint32_t table)
+{
+	Domain *dom = newDomain(nameId, arity);
+	if(dom->size() > 0)
+	{
+		std::ostringstream oss;
+		oss << "#sql " << string(nameId) << "/" << arity << " : \"" << string(db) << "\" : \"" << string(table) << "\".";
+		throw TypeException("atoms of a #sql predicate cannot be derived", StrLoc(this, loc), oss.str());
+	}
+	sources_.push_back(new SqlSource(this, loc, string(db), string(table), arity));
+	dom->source(&sources_.back());
+}
+
 BodyOrderHeuristic& Grounder::heuristic() const
 {
 	return *heuristic_;
@@ -237,6 +300,7 @@ void Grounder::addInternal(Statement *s)
 	{
 		s->enqueue(this);
 		ground_();
+		if(profile_.get()) { profile_->fact(s); }
 		delete s;
 		stats_.addFact();
 	}
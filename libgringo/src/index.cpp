@@ -24,6 +24,10 @@ bool Index::init(Grounder*)
 	return hasNew();
 }
 
+void Index::mark(Domain *) { }
+
+void Index::rollback(Domain *) { }
+
 Index::~Index() { }
 
 // ========================= StaticIndex =========================
@@ -97,6 +97,8 @@ bool Instantiator::ground(Grounder *g)
 			l-= !matched.first;
 			if(l == -1) { break; }
 			matched = indices_[l].nextMatch(g, l);
+			counters_.probes++;
+			counters_.matches+= matched.first;
 			numNew -= new_[l];
 			new_[l] = matched.second;
 			numNew += matched.first && matched.second;
@@ -105,6 +107,7 @@ bool Instantiator::ground(Grounder *g)
 		{
 			if(++l == static_cast<int>(indices_.size()))
 			{
+				counters_.instances++;
 				if(!grounded_(g))
 				{
 					ret = false;
@@ -115,6 +118,8 @@ bool Instantiator::ground(Grounder *g)
 			else
 			{
 				matched = indices_[l].firstMatch(g, l);
+				counters_.probes++;
+				counters_.matches+= matched.first;
 				new_[l] = matched.second;
 				numNew += matched.first && matched.second;
 			}
@@ -0,0 +1,380 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gringo/joinindex.h>
+#include <gringo/predlit.h>
+#include <gringo/domain.h>
+#include <gringo/grounder.h>
+#include <gringo/term.h>
+
+namespace
+{
+	//! an arbitrary but fixed order on values (only used for sorting tuples)
+	bool valLess(const Val &a, const Val &b)
+	{
+		if(a.type != b.type) { return a.type < b.type; }
+		switch(a.type)
+		{
+			case Val::INF:
+			case Val::SUP:
+			case Val::UNDEF: { return false; }
+			case Val::NUM:   { return a.num < b.num; }
+			default:         { return a.index < b.index; }
+		}
+	}
+
+	struct TupleLess
+	{
+		TupleLess(const ValVec &vals, const VarVec &origin, uint32_t width) : vals(vals), origin(origin), width(width) { }
+		bool operator()(uint32_t a, uint32_t b) const
+		{
+			for(uint32_t i = 0; i < width; i++)
+			{
+				if(valLess(vals[a * width + i], vals[b * width + i])) { return true; }
+				if(valLess(vals[b * width + i], vals[a * width + i])) { return false; }
+			}
+			return origin[a] < origin[b];
+		}
+		bool equal(uint32_t a, uint32_t b) const
+		{
+			return std::equal(vals.begin() + a * width, vals.begin() + (a + 1) * width, vals.begin() + b * width);
+		}
+		const ValVec &vals;
+		const VarVec &origin;
+		uint32_t      width;
+	};
+}
+
+JoinIndex::Relation::Relation(PredLit *pred)
+	: pred(pred)
+	, extended(0)
+	, finished(0)
+	, newest(0)
+{
+}
+
+JoinIndex::JoinIndex(const PredLitVec &preds, VarSet &bound)
+	: numBound_(0)
+{
+	typedef std::map<uint32_t, uint32_t> OccMap;
+	OccMap occ;
+	foreach(PredLit *pred, preds)
+	{
+		rels_.push_back(Relation(pred));
+		VarSet vars;
+		pred->vars(vars);
+		foreach(uint32_t var, vars) { occ[var]++; }
+	}
+	// variables bound before are only checked, the remaining variables
+	// are bound in the order of the number of literals they occur in
+	std::vector<std::pair<int, uint32_t> > order;
+	foreach(OccMap::value_type &ref, occ)
+	{
+		if(bound.find(ref.first) != bound.end()) { vars_.push_back(ref.first); }
+		else { order.push_back(std::make_pair(-(int)ref.second, ref.first)); }
+	}
+	numBound_ = vars_.size();
+	std::sort(order.begin(), order.end());
+	for(size_t i = 0; i < order.size(); i++) { vars_.push_back(order[i].second); }
+
+	OccMap level;
+	for(uint32_t i = 0; i < vars_.size(); i++) { level[vars_[i]] = i; }
+	columns_.resize(vars_.size());
+	for(uint32_t r = 0; r < rels_.size(); r++)
+	{
+		Relation &rel = rels_[r];
+		VarSet vars;
+		rel.pred->vars(vars);
+		foreach(uint32_t var, vars) { rel.levels.push_back(level[var]); }
+		std::sort(rel.levels.begin(), rel.levels.end());
+		for(uint32_t c = 0; c < rel.levels.size(); c++)
+		{
+			rel.vars.push_back(vars_[rel.levels[c]]);
+			columns_[rel.levels[c]].push_back(std::make_pair(r, c));
+		}
+	}
+	ranges_.resize((vars_.size() + 1) * rels_.size());
+	driver_.resize(vars_.size());
+	pos_.resize(vars_.size());
+	end_.resize(vars_.size());
+	binding_.resize(vars_.size());
+	bound.insert(vars_.begin(), vars_.end());
+}
+
+void JoinIndex::cyclic(const PredLitVec &preds, const VarSet &bound, PredLitVec &core)
+{
+	std::vector<VarSet> edges(preds.size());
+	std::vector<bool>   removed(preds.size(), false);
+	for(size_t i = 0; i < preds.size(); i++)
+	{
+		VarSet vars;
+		preds[i]->vars(vars);
+		std::set_difference(vars.begin(), vars.end(), bound.begin(), bound.end(), std::inserter(edges[i], edges[i].end()));
+	}
+	bool changed = true;
+	while(changed)
+	{
+		changed = false;
+		// remove variables that occur in one literal only
+		std::map<uint32_t, uint32_t> occ;
+		for(size_t i = 0; i < edges.size(); i++)
+		{
+			if(!removed[i]) { foreach(uint32_t var, edges[i]) { occ[var]++; } }
+		}
+		for(size_t i = 0; i < edges.size(); i++)
+		{
+			if(removed[i]) { continue; }
+			for(VarSet::iterator it = edges[i].begin(); it != edges[i].end(); )
+			{
+				if(occ[*it] == 1) { edges[i].erase(it++); changed = true; }
+				else { ++it; }
+			}
+		}
+		// remove literals whose variables are contained in another literal
+		for(size_t i = 0; i < edges.size(); i++)
+		{
+			if(removed[i]) { continue; }
+			for(size_t j = 0; j < edges.size(); j++)
+			{
+				if(i != j && !removed[j] && std::includes(edges[j].begin(), edges[j].end(), edges[i].begin(), edges[i].end()))
+				{
+					removed[i] = true;
+					changed    = true;
+					break;
+				}
+			}
+			if(!removed[i] && edges[i].empty())
+			{
+				removed[i] = true;
+				changed    = true;
+			}
+		}
+	}
+	for(size_t i = 0; i < preds.size(); i++)
+	{
+		if(!removed[i]) { core.push_back(preds[i]); }
+	}
+}
+
+void JoinIndex::extend(Grounder *g, Relation &rel)
+{
+	Domain *dom = rel.pred->dom();
+	if(rel.extended == dom->size()) { return; }
+	if(dom->marked(dom->size() - 1)) { dom->track(this); }
+	uint32_t sorted = rel.origin.size();
+	bool     added  = false;
+	for(uint32_t i = rel.extended; i < dom->size(); i++)
+	{
+		ValVec::const_iterator k = dom->vals(i);
+		bool unified = true;
+		foreach(const Term &term, rel.pred->terms())
+		{
+			if(!term.unify(g, *k++, 0))
+			{
+				unified = false;
+				break;
+			}
+		}
+		if(unified)
+		{
+			foreach(uint32_t var, rel.vars) { rel.vals.push_back(g->val(var)); }
+			rel.origin.push_back(i);
+			added = true;
+		}
+		foreach(uint32_t var, rel.vars) { g->unbind(var); }
+	}
+	rel.extended = dom->size();
+	if(!added) { return; }
+
+	// the old tuples are already sorted, sort the new ones, merge them in and remove duplicates keeping the oldest
+	uint32_t  width = rel.vars.size();
+	TupleLess cmp(rel.vals, rel.origin, width);
+	VarVec    perm;
+	perm.reserve(rel.origin.size());
+	for(uint32_t i = 0; i < rel.origin.size(); i++) { perm.push_back(i); }
+	std::sort(perm.begin() + sorted, perm.end(), cmp);
+	std::inplace_merge(perm.begin(), perm.begin() + sorted, perm.end(), cmp);
+	ValVec vals;
+	VarVec origin;
+	rel.newest = 0;
+	for(uint32_t i = 0; i < perm.size(); i++)
+	{
+		if(i > 0 && cmp.equal(perm[i - 1], perm[i])) { continue; }
+		vals.insert(vals.end(), rel.vals.begin() + perm[i] * width, rel.vals.begin() + (perm[i] + 1) * width);
+		origin.push_back(rel.origin[perm[i]]);
+		rel.newest = std::max(rel.newest, rel.origin[perm[i]]);
+	}
+	rel.vals.swap(vals);
+	rel.origin.swap(origin);
+}
+
+void JoinIndex::open(uint32_t level)
+{
+	const ColumnVec &cols = columns_[level];
+	uint32_t best = 0;
+	for(uint32_t i = 1; i < cols.size(); i++)
+	{
+		const Range &a = range(level, cols[i].first);
+		const Range &b = range(level, cols[best].first);
+		if(a.second - a.first < b.second - b.first) { best = i; }
+	}
+	driver_[level] = best;
+	pos_[level]    = range(level, cols[best].first).first;
+}
+
+bool JoinIndex::seek(Grounder *g, uint32_t level)
+{
+	const ColumnVec &cols = columns_[level];
+	const Relation  &drv  = rels_[cols[driver_[level]].first];
+	uint32_t         col  = cols[driver_[level]].second;
+	uint32_t         hi   = range(level, cols[driver_[level]].first).second;
+	uint32_t         w    = drv.vars.size();
+	while(pos_[level] < hi)
+	{
+		const Val &val = level < numBound_ ? g->val(vars_[level]) : drv.vals[pos_[level] * w + col];
+		// variables bound before the index have only one candidate
+		end_[level] = hi;
+		for(uint32_t r = 0; r < rels_.size(); r++) { range(level + 1, r) = range(level, r); }
+		bool matched = true;
+		foreach(const ColumnVec::value_type &c, cols)
+		{
+			const Relation &rel = rels_[c.first];
+			uint32_t width = rel.vars.size();
+			Range &next = range(level + 1, c.first);
+			uint32_t lo = next.first, up = next.second;
+			// lower bound
+			for(uint32_t len = up - lo; len > 0; )
+			{
+				uint32_t half = len / 2;
+				if(valLess(rel.vals[(lo + half) * width + c.second], val)) { lo += half + 1; len -= half + 1; }
+				else { len = half; }
+			}
+			// upper bound
+			uint32_t hi2 = lo;
+			for(uint32_t len = up - lo; len > 0; )
+			{
+				uint32_t half = len / 2;
+				if(!valLess(val, rel.vals[(hi2 + half) * width + c.second])) { hi2 += half + 1; len -= half + 1; }
+				else { len = half; }
+			}
+			next = Range(lo, hi2);
+			if(level >= numBound_ && &rel == &drv) { end_[level] = hi2; }
+			if(lo == hi2) { matched = false; }
+		}
+		if(matched)
+		{
+			binding_[level] = val;
+			return true;
+		}
+		pos_[level] = end_[level];
+	}
+	return false;
+}
+
+Index::Match JoinIndex::match(Grounder *g, int binder, uint32_t level)
+{
+	for(;;)
+	{
+		if(seek(g, level))
+		{
+			if(level >= numBound_) { g->val(vars_[level], binding_[level], binder); }
+			if(++level == vars_.size())
+			{
+				bool isNew = false;
+				for(uint32_t r = 0; r < rels_.size(); r++)
+				{
+					if(rels_[r].origin[range(level, r).first] >= rels_[r].finished) { isNew = true; }
+				}
+				return Match(true, isNew);
+			}
+			open(level);
+		}
+		else
+		{
+			if(level == 0) { return Match(false, false); }
+			level--;
+			pos_[level] = end_[level];
+		}
+	}
+}
+
+Index::Match JoinIndex::firstMatch(Grounder *g, int binder)
+{
+	for(uint32_t r = 0; r < rels_.size(); r++) { range(0, r) = Range(0, rels_[r].origin.size()); }
+	open(0);
+	return match(g, binder, 0);
+}
+
+Index::Match JoinIndex::nextMatch(Grounder *g, int binder)
+{
+	uint32_t level = vars_.size() - 1;
+	pos_[level] = end_[level];
+	return match(g, binder, level);
+}
+
+void JoinIndex::reset()
+{
+	foreach(Relation &rel, rels_) { rel.finished = 0; }
+}
+
+void JoinIndex::finish()
+{
+	foreach(Relation &rel, rels_) { rel.finished = rel.extended; }
+}
+
+bool JoinIndex::hasNew() const
+{
+	foreach(const Relation &rel, rels_)
+	{
+		if(!rel.origin.empty() && rel.newest >= rel.finished) { return true; }
+	}
+	return false;
+}
+
+void JoinIndex::rollback(Domain *dom)
+{
+	foreach(Relation &rel, rels_)
+	{
+		if(rel.pred->dom() != dom) { continue; }
+		// removing the tuples of dropped atoms keeps the remaining ones sorted
+		uint32_t width = rel.vars.size();
+		uint32_t j     = 0;
+		rel.newest     = 0;
+		for(uint32_t i = 0; i < rel.origin.size(); i++)
+		{
+			if(rel.origin[i] >= dom->size()) { continue; }
+			std::copy(rel.vals.begin() + i * width, rel.vals.begin() + (i + 1) * width, rel.vals.begin() + j * width);
+			rel.origin[j++] = rel.origin[i];
+			rel.newest      = std::max(rel.newest, rel.origin[i]);
+		}
+		rel.vals.resize(j * width);
+		rel.origin.resize(j);
+		rel.extended = std::min(rel.extended, dom->size());
+		rel.finished = std::min(rel.finished, dom->size());
+	}
+}
+
+bool JoinIndex::init(Grounder *g)
+{
+	foreach(Relation &rel, rels_) { extend(g, rel); }
+	return hasNew();
+}
+
+JoinIndex::~JoinIndex()
+{
+}
+
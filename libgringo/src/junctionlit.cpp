@@ -21,6 +21,7 @@
 #include "gringo/index.h"
 #include "gringo/grounder.h"
 #include "gringo/output.h"
+#include "gringo/profile.h"
 
 struct JunctionIndex : public StaticIndex
 {
@@ -292,7 +293,10 @@ void JunctionCond::init(Grounder *g, JunctionIndex &parent)
 
 bool JunctionCond::ground(Grounder *g)
 {
-	return inst_->ground(g);
+	double start = g->profile() ? Profile::now() : 0;
+	bool ret = inst_->ground(g);
+	if(g->profile()) { g->profile()->grounded(this, inst_.get(), Profile::now() - start); }
+	return ret;
 }
 
 void JunctionCond::visit(PrgVisitor *visitor)
@@ -70,6 +70,7 @@ void LparseConverter::Symbol::print(const Storage *s, std::ostream &out) const
 LparseConverter::LparseConverter(bool shiftDisj)
 	: prioMap_(boost::bind(static_cast<int (Val::*)(const Val&, Storage *) const>(&Val::compare), _1, _2, boost::ref(s_)) < 0)
 	, shiftDisjunctions_(shiftDisj)
+	, simplify_(false)
 {
 	initPrinters<LparseConverter>();
 }
@@ -79,6 +80,12 @@ void LparseConverter::initialize()
 	false_ = symbol();
 }
 
+void LparseConverter::restoreSymbol(Symbol::Repr &repr, uint32_t symbol, bool external)
+{
+	SymbolMap::iterator it = symbolMap_.insert(Symbol(repr, symbol)).first;
+	it->external = external;
+}
+
 LparseConverter::Symbol const &LparseConverter::symbol(uint32_t symbol)
 {
 	return *symbolMap_.get<BySymbol>().find(symbol);
@@ -247,7 +254,8 @@ void LparseConverter::printBasicRule(uint32_t head, uint32_t n, ...)
 		else if(v < 0) { neg.push_back(-v); }
 	}
 	va_end(vl);
-	printBasicRule(head, pos, neg);
+	AtomVec heads(1, head);
+	if(simplifyRule(heads, pos, neg, false)) { printBasicRule(head, pos, neg); }
 }
 
 void LparseConverter::printBasicRule(uint32_t head, const LitVec &lits)
@@ -258,7 +266,52 @@ void LparseConverter::printBasicRule(uint32_t head, const LitVec &lits)
 		if(lit > 0) { pos.push_back(lit); }
 		else        { neg.push_back(-lit); }
 	}
-	printBasicRule(head, pos, neg);
+	AtomVec heads(1, head);
+	if(simplifyRule(heads, pos, neg, false)) { printBasicRule(head, pos, neg); }
+}
+
+bool LparseConverter::simplifyRule(AtomVec &head, AtomVec &pos, AtomVec &neg, bool choice)
+{
+	if(!simplify_) { return true; }
+	// rules with a false body are dropped
+	foreach(uint32_t sym, neg)
+	{
+		if(fact(sym)) { return false; }
+	}
+	// true body literals are dropped
+	pos.erase(std::remove_if(pos.begin(), pos.end(), boost::bind(&LparseConverter::fact, this, _1)), pos.end());
+	boost::range::sort(pos);
+	pos.resize(boost::range::unique(pos).size());
+	boost::range::sort(neg);
+	neg.resize(boost::range::unique(neg).size());
+	// rules with a true head are satisfied anyway, facts in choices need no choice
+	if(choice)
+	{
+		head.erase(std::remove_if(head.begin(), head.end(), boost::bind(&LparseConverter::fact, this, _1)), head.end());
+		if(head.empty()) { return false; }
+	}
+	else
+	{
+		foreach(uint32_t sym, head)
+		{
+			if(fact(sym)) { return false; }
+		}
+	}
+	// identical rules are printed only once
+	AtomVec rule;
+	rule.push_back(choice);
+	rule.push_back(head.size());
+	rule.insert(rule.end(), head.begin(), head.end());
+	rule.push_back(pos.size());
+	rule.insert(rule.end(), pos.begin(), pos.end());
+	rule.insert(rule.end(), neg.begin(), neg.end());
+	if(!rules_.insert(rule).second) { return false; }
+	if(!choice && head.size() == 1 && pos.empty() && neg.empty())
+	{
+		if(facts_.size() <= head.back()) { facts_.resize(head.back() + 1, false); }
+		facts_[head.back()] = true;
+	}
+	return true;
 }
 
 void LparseConverter::transformDisjunctiveRule(uint32_t n, ...)
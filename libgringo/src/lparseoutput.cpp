@@ -102,9 +102,9 @@ void LparseOutput::printExternalTableEntry(const Symbol &symbol)
 		out_ << "E\n";
 		hasExternal_ = true;
 	}
-	out_ << symbol.symbol << " ";
-	symbol.print(storage(), out_);
-	out_ << "\n";
+	std::ostringstream name;
+	symbol.print(storage(), name);
+	out_ << symbol.symbol << " " << name.str() << "\n";
 }
 
 uint32_t LparseOutput::symbol()
@@ -124,5 +124,6 @@ void LparseOutput::doFinalize()
 	printExternalTable();
 	if(hasExternal_) out_ << "0\n";
 	out_ << "1\n";
+	out_.flush();
 }
 
@@ -205,7 +205,7 @@ namespace
 			vals.push_back(toVal(L, -1));
 			lua_pop(L, 1); // pop val
 		}
-		uint32_t index = storage->index(Func(storage, storage->index(std::string(name)), vals));
+		uint32_t index = storage->index(storage->index(std::string(name)), vals);
 		pushVal(L, Val::func(index));
 		return 1;
 	}
@@ -221,7 +221,7 @@ namespace
 			vals.push_back(toVal(L, -1));
 			lua_pop(L, 1); // pop val
 		}
-		uint32_t index = storage->index(Func(storage, storage->index(std::string("")), vals));
+		uint32_t index = storage->index(storage->index(std::string("")), vals);
 		pushVal(L, Val::func(index));
 		return 1;
 	}
@@ -27,6 +27,9 @@ namespace lparseconverter_impl
 namespace
 {
 
+//! longest chain of an extensible aggregate, aggregates with larger bounds are printed as usual
+const int64_t MAX_CHAIN = 64;
+
 template <class C>
 void sort_unique(C &c)
 {
@@ -68,7 +71,7 @@ struct CondLess
 
 void AggrCondPrinter::Cond::simplify()
 {
-	foreach(HeadLits hl, lits) { sort_unique(hl.second); }
+	foreach(HeadLits &hl, lits) { sort_unique(hl.second); }
 	sort_unique(lits);
 }
 
@@ -76,9 +79,9 @@ void AggrCondPrinter::Cond::simplify()
 
 void AggrCondPrinter::begin(AggrCond::Style, State state, const ValVec &set)
 {
-	CondMap &conds = stateMap_.insert(StateMap::value_type(state, CondMap(boost::bind(Val::compare, output()->storage(), _1, _2) < 0))).first->second;
-	current_ = &conds[set];
+	current_ = &stateMap_[state][set];
 	current_->lits.push_back(Cond::HeadLits());
+	if(changed_.empty() || changed_.back() != state) { changed_.push_back(state); }
 }
 
 AggrCondPrinter::CondMap *AggrCondPrinter::state(State state)
@@ -88,6 +91,18 @@ AggrCondPrinter::CondMap *AggrCondPrinter::state(State state)
 	else                      { return 0; }
 }
 
+uint32_t AggrCondPrinter::bodySymbol(const LitVec &lits)
+{
+	// identical condition bodies of different aggregates share one atom
+	std::pair<BodyMap::iterator, bool> res = bodies_.insert(BodyMap::value_type(lits, 0));
+	if(res.second)
+	{
+		res.first->second = output_->symbol();
+		output_->printBasicRule(res.first->second, lits);
+	}
+	return res.first->second;
+}
+
 void AggrCondPrinter::endHead()
 {
 	LitVec &lits = current_->lits.back().second;
@@ -189,7 +204,7 @@ template <class T, uint32_t Type>
 void AggrLitPrinter<T, Type>::end()
 {
 	std::pair<TodoMap::iterator, bool> res = todo_.insert(TodoMap::value_type(key_, val_));
-	if (res.second) { res.first->second.symbol = output_->symbol(); }
+	if (res.second) { res.first->second.symbol = aggrSymbol(key_); }
 	RulePrinter *printer = static_cast<RulePrinter*>(output()->template printer<Rule::Printer>());
 	if(val_.head)
 	{
@@ -293,7 +308,6 @@ bool AggrLitPrinter<T, Type>::handleAggr(const AggrBoundCheck &b, const AggrTodo
 			}
 			else
 			{
-				int32_t noHead = 0;
 				foreach(AggrCondPrinter::Cond::HeadLits &hl, cond.second->lits)
 				{
 					if(hl.first != 0 || hasBound)
@@ -308,18 +322,7 @@ bool AggrLitPrinter<T, Type>::handleAggr(const AggrBoundCheck &b, const AggrTodo
 						{
 							if(hl.second.size() > 1)
 							{
-								uint32_t cond;
-								if(hl.first == 0)
-								{
-									if(noHead == 0)
-									{
-										cond   = output()->symbol();
-										noHead = cond;
-									}
-									else { cond = noHead; }
-								}
-								else { cond = output()->symbol(); }
-								output()->printBasicRule(cond, pos, neg);
+								uint32_t cond = condPrinter()->bodySymbol(hl.second);
 								pos.clear();
 								neg.clear();
 								pos.push_back(cond);
@@ -370,12 +373,24 @@ bool AggrLitPrinter<T, Type>::handleAggr(const AggrBoundCheck &b, const AggrTodo
 	return false;
 }
 
+template <class T, uint32_t Type>
+uint32_t AggrLitPrinter<T, Type>::aggrSymbol(const AggrTodoKey &)
+{
+	return output_->symbol();
+}
+
+template <class T, uint32_t Type>
+void AggrLitPrinter<T, Type>::extend()
+{
+}
+
 template <class T, uint32_t Type>
 void AggrLitPrinter<T, Type>::finish()
 {
+	extend();
 	foreach(TodoMap::value_type &todo, todo_)
 	{
-		AggrCondPrinter::CondMap *conds = static_cast<AggrCondPrinter*>(output()->template printer<AggrCond::Printer>())->state(todo.first.state);
+		AggrCondPrinter::CondMap *conds = condPrinter()->state(todo.first.state);
 		if(conds)
 		{
 			foreach(AggrCondPrinter::CondMap::value_type &c, *conds) { c.second.simplify(); }
@@ -393,6 +408,12 @@ LparseConverter *AggrLitPrinter<T, Type>::output() const
 	return output_;
 }
 
+template <class T, uint32_t Type>
+AggrCondPrinter *AggrLitPrinter<T, Type>::condPrinter() const
+{
+	return static_cast<AggrCondPrinter*>(output_->template printer<AggrCond::Printer>());
+}
+
 /*
 template <class T, uint32_t Type>
 std::ostream &AggrLitPrinter<T, Type>::out() const
@@ -406,6 +427,27 @@ AggrLitPrinter<T, Type>::~AggrLitPrinter()
 {
 }
 
+////////////////////////////////// SumAggrLitPrinter::Element //////////////////////////////////
+
+SumAggrLitPrinter::Element::Element()
+	: fact(false)
+{
+}
+
+////////////////////////////////// SumAggrLitPrinter::Extension //////////////////////////////////
+
+SumAggrLitPrinter::Extension::Extension(const AggrTodoKey &key, uint32_t symbol)
+	: key(key)
+	, symbol(symbol)
+	, dirty(false)
+{
+}
+
+bool SumAggrLitPrinter::Extension::closed() const
+{
+	return lower.empty() && upper.empty();
+}
+
 ////////////////////////////////// SumAggrLitPrinter //////////////////////////////////
 
 SumAggrLitPrinter::SumAggrLitPrinter(LparseConverter *output)
@@ -438,6 +480,11 @@ bool SumAggrLitPrinter::analyze(const SetCondVec::value_type &a, int64_t &min, i
 
 void SumAggrLitPrinter::printAggr(const AggrTodoKey &key, const AggrTodoVal &val, SetCondVec &condVec)
 {
+	ExtensionMap::iterator ext = ext_.find(key.state);
+	// NOTE: new elements of aggregates printed in earlier steps are added by extend
+	if(ext != ext_.end() && ext->second.key == key) { return; }
+	if(printExtensible(key, val, condVec)) { return; }
+
 	std::sort(condVec.begin(), condVec.end(), CondLess());
 	condVec.erase(combine_adjacent(condVec.begin(), condVec.end(), CondEqual(), &SumAggrLitPrinter::combine), condVec.end());
 	int64_t min = 0, max = 0, fix = 0;
@@ -477,11 +524,7 @@ void SumAggrLitPrinter::printAggr(const AggrTodoKey &key, const AggrTodoVal &val
 void SumAggrLitPrinter::printSum(uint32_t sym, int64_t bound, LitVec &condSyms, SetCondVec &condVec)
 {
 	LitVec::iterator it = condSyms.begin();
-	AtomVec pos, neg;
-	LparseConverter::WeightVec wPos, wNeg;
-	int64_t max  = 0;
-	int32_t maxi = 0;
-	bool card    = true;
+	WeightLitVec lits;
 	foreach(SetCondVec::value_type &cond, condVec)
 	{
 		int32_t condSym = *it++;
@@ -496,21 +539,41 @@ void SumAggrLitPrinter::printSum(uint32_t sym, int64_t bound, LitVec &condSyms,
 				weight *= -1;
 				bound  += weight;
 			}
-			if(condSym > 0)
-			{
-				pos.push_back(condSym);
-				wPos.push_back(weight);
-			}
-			else if(condSym < 0)
-			{
-				neg.push_back(-condSym);
-				wNeg.push_back(weight);
-			}
-			if(weight != 1) { card = false; }
-			max += weight;
-			maxi = std::max(maxi, weight);
+			lits.push_back(WeightLit(condSym, weight));
 		}
 	}
+	printWeight(sym, bound, lits);
+}
+
+void SumAggrLitPrinter::printWeight(uint32_t sym, int64_t bound, const WeightLitVec &lits)
+{
+	AtomVec pos, neg;
+	LparseConverter::WeightVec wPos, wNeg;
+	int64_t max  = 0;
+	int32_t maxi = 0;
+	bool card    = true;
+	foreach(const WeightLit &lit, lits)
+	{
+		if(output()->simplify() && output()->fact(std::abs(lit.first)))
+		{
+			// facts reduce the bound and negated facts never contribute
+			if(lit.first > 0) { bound -= lit.second; }
+			continue;
+		}
+		if(lit.first > 0)
+		{
+			pos.push_back(lit.first);
+			wPos.push_back(lit.second);
+		}
+		else if(lit.first < 0)
+		{
+			neg.push_back(-lit.first);
+			wNeg.push_back(lit.second);
+		}
+		if(lit.second != 1) { card = false; }
+		max += lit.second;
+		maxi = std::max(maxi, lit.second);
+	}
 	if(bound > max)             { }
 	else if(bound <= 0)         { output()->printBasicRule(sym, 0); }
 	else if(max - maxi < bound) { output()->printBasicRule(sym, pos, neg); }
@@ -518,6 +581,197 @@ void SumAggrLitPrinter::printSum(uint32_t sym, int64_t bound, LitVec &condSyms,
 	else                        { output()->printWeightRule(sym, bound, pos, neg, wPos, wNeg); }
 }
 
+uint32_t SumAggrLitPrinter::aggrSymbol(const AggrTodoKey &key)
+{
+	ExtensionMap::iterator ext = ext_.find(key.state);
+	if(ext != ext_.end() && ext->second.key == key) { return ext->second.symbol; }
+	else                                            { return output()->symbol(); }
+}
+
+int32_t SumAggrLitPrinter::condSym(const Cond::HeadLitsVec &lits)
+{
+	LitVec syms;
+	foreach(const Cond::HeadLits &hl, lits)
+	{
+		assert(hl.first == 0);
+		if(hl.second.empty())         { return 0; }
+		else if(hl.second.size() > 1) { syms.push_back(condPrinter()->bodySymbol(hl.second)); }
+		else { syms.push_back(hl.second.back()); }
+	}
+	if(syms.size() == 1) { return syms.back(); }
+	int32_t sym = output()->symbol();
+	foreach(int32_t lit, syms) { output()->printBasicRule(sym, 1, lit); }
+	return sym;
+}
+
+bool SumAggrLitPrinter::openChain(int64_t bound, AtomVec &chain)
+{
+	for(int64_t i = 0; i < bound; i++)
+	{
+		uint32_t sym = output()->frozenSymbol();
+		if(sym == 0) { return false; }
+		chain.push_back(sym);
+	}
+	return true;
+}
+
+bool SumAggrLitPrinter::printExtensible(const AggrTodoKey &key, const AggrTodoVal &val, SetCondVec &condVec)
+{
+	if(val.head || ext_.find(key.state) != ext_.end()) { return false; }
+	bool hasLower = key.lower.type == Val::NUM;
+	bool hasUpper = key.upper.type == Val::NUM;
+	if((!hasLower && key.lower.type != Val::INF) || (!hasUpper && key.upper.type != Val::SUP)) { return false; }
+	int64_t fix = 0;
+	foreach(SetCond &cond, condVec)
+	{
+		int32_t weight = cond.first[0].num;
+		if(weight < 0) { return false; }
+		foreach(Cond::HeadLits &hl, cond.second->lits)
+		{
+			if(hl.second.empty())
+			{
+				fix += weight;
+				break;
+			}
+		}
+	}
+	// aggregates whose truth value cannot change anymore are printed as usual
+	int64_t lower = hasLower ? key.lower.num + !key.lleq - fix : 0;
+	int64_t upper = hasUpper ? key.upper.num - !key.uleq - fix + 1 : 0;
+	if((hasUpper && upper <= 0) || (!hasUpper && lower <= 0)) { return false; }
+	if(lower > MAX_CHAIN || upper > MAX_CHAIN) { return false; }
+
+	Extension ext(key, val.symbol);
+	if(!openChain(lower, ext.lower) || (hasUpper && !openChain(upper, ext.upper))) { return false; }
+	WeightLitVec lits;
+	foreach(SetCond &cond, condVec)
+	{
+		Element &elem = ext.elems[cond.first];
+		elem.lits = cond.second->lits;
+		elem.syms.push_back(condSym(elem.lits));
+		elem.fact = elem.syms.back() == 0;
+		if(!elem.fact && cond.first[0].num > 0) { lits.push_back(WeightLit(elem.syms.back(), cond.first[0].num)); }
+	}
+	uint32_t l = 0, u = 0;
+	if(lower > 0)
+	{
+		WeightLitVec chain(lits);
+		foreach(uint32_t sym, ext.lower) { chain.push_back(WeightLit(sym, 1)); }
+		l = !hasUpper ? val.symbol : output()->symbol();
+		printWeight(l, lower, chain);
+	}
+	if(hasUpper)
+	{
+		WeightLitVec chain(lits);
+		foreach(uint32_t sym, ext.upper) { chain.push_back(WeightLit(sym, 1)); }
+		u = output()->symbol();
+		printWeight(u, upper, chain);
+	}
+	if(l != val.symbol) { output()->printBasicRule(val.symbol, 2, l, -u); }
+	ext_.insert(ExtensionMap::value_type(key.state, ext));
+	return true;
+}
+
+void SumAggrLitPrinter::extendChain(AtomVec &chain, int64_t fix, const WeightLitVec &lits)
+{
+	// sequential counter: the i-th atom of a layer holds if the elements
+	// added so far plus the next chain sum up to at least i+1
+	int64_t open = std::max<int64_t>(0, int64_t(chain.size()) - fix);
+	AtomVec next;
+	bool frozen = openChain(open, next);
+	assert(frozen);
+	(void)frozen;
+	AtomVec layer(next);
+	foreach(const WeightLit &lit, lits)
+	{
+		AtomVec sum;
+		for(int64_t i = 0; i < open; i++)
+		{
+			uint32_t sym = output()->symbol();
+			output()->printBasicRule(sym, 1, layer[i]);
+			if(i < lit.second) { output()->printBasicRule(sym, 1, lit.first); }
+			else               { output()->printBasicRule(sym, 2, lit.first, layer[i - lit.second]); }
+			sum.push_back(sym);
+		}
+		layer.swap(sum);
+	}
+	for(int64_t i = 0; i < int64_t(chain.size()); i++)
+	{
+		if(i < fix) { output()->printBasicRule(chain[i], 0); }
+		else        { output()->printBasicRule(chain[i], 1, layer[i - fix]); }
+	}
+	chain.swap(next);
+}
+
+void SumAggrLitPrinter::close(Extension &ext)
+{
+	foreach(uint32_t sym, ext.lower) { output()->unfreezeSymbol(sym); }
+	foreach(uint32_t sym, ext.upper) { output()->unfreezeSymbol(sym); }
+	ext.lower.clear();
+	ext.upper.clear();
+	ext.elems.clear();
+}
+
+void SumAggrLitPrinter::extend()
+{
+	AggrCondPrinter *printer = condPrinter();
+	AggrCondPrinter::StateVec changed;
+	printer->takeChanged(changed);
+	std::vector<Extension*> todo;
+	foreach(State state, changed)
+	{
+		ExtensionMap::iterator it = ext_.find(state);
+		if(it != ext_.end() && !it->second.dirty && !it->second.closed())
+		{
+			it->second.dirty = true;
+			todo.push_back(&it->second);
+		}
+	}
+	foreach(Extension *ext, todo)
+	{
+		ext->dirty = false;
+		int64_t fix = 0;
+		WeightLitVec lits;
+		foreach(AggrCondPrinter::CondMap::value_type &c, *printer->state(ext->key.state))
+		{
+			Element &elem = ext->elems[c.first];
+			if(elem.fact) { continue; }
+			c.second.simplify();
+			Cond::HeadLitsVec added;
+			std::set_difference(c.second.lits.begin(), c.second.lits.end(), elem.lits.begin(), elem.lits.end(), std::back_inserter(added));
+			if(added.empty()) { continue; }
+			elem.lits = c.second.lits;
+			int32_t sym = condSym(added);
+			// an element is counted only once even if it gets additional conditions
+			if(!elem.syms.empty())
+			{
+				LitVec body;
+				if(sym != 0) { body.push_back(sym); }
+				foreach(int32_t old, elem.syms) { body.push_back(-old); }
+				sym = output()->symbol();
+				output()->printBasicRule(sym, body);
+			}
+			elem.syms.push_back(sym);
+			elem.fact = sym == 0;
+			int32_t weight = c.first[0].num;
+			// NOTE: the chains cannot represent negative contributions,
+			//       such elements are ignored like before (only possible for #sum)
+			if(weight <= 0) { continue; }
+			if(sym == 0) { fix += weight; }
+			else         { lits.push_back(WeightLit(sym, weight)); }
+		}
+		if(fix > 0 || !lits.empty())
+		{
+			extendChain(ext->lower, fix, lits);
+			extendChain(ext->upper, fix, lits);
+		}
+		// once the upper bound is exceeded or the lower bound is reached without
+		// an upper bound, later elements cannot change the aggregate anymore
+		bool hasUpper = ext->key.upper.type == Val::NUM;
+		if((hasUpper && ext->upper.empty()) || (!hasUpper && ext->lower.empty())) { close(*ext); }
+	}
+}
+
 ////////////////////////////////// MinMaxAggrLitPrinter //////////////////////////////////
 
 template <uint32_t T>
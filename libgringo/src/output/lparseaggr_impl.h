@@ -42,13 +42,18 @@ public:
 		typedef std::vector<HeadLits> HeadLitsVec;
 		HeadLitsVec lits;
 	};
-	typedef std::map<ValVec, Cond, boost::function2<bool, ValVec, ValVec> > CondMap;
+	typedef boost::unordered_map<ValVec, Cond> CondMap;
+	typedef std::vector<State> StateVec;
 private:
 	typedef boost::unordered_map<State, CondMap> StateMap;
+	typedef boost::unordered_map<LitVec, uint32_t> BodyMap;
 public:
 	AggrCondPrinter(LparseConverter *output);
 	void begin(AggrCond::Style style, State state, const ValVec &set);
 	CondMap *state(State state);
+	//! moves the states that received conditions since the last call into states
+	void takeChanged(StateVec &states);
+	uint32_t bodySymbol(const LitVec &lits);
 	void endHead();
 	void trueLit();
 	void print(PredLitRep *l);
@@ -59,6 +64,8 @@ private:
 	LparseConverter *output_;
 	Cond            *current_;
 	StateMap         stateMap_;
+	StateVec         changed_;
+	BodyMap          bodies_;
 };
 
 struct AggrTodoKey
@@ -123,7 +130,10 @@ public:
 	int32_t getCondSym(const SetCond &cond, LitVec::iterator &lit);
 	void getCondSyms(LitVec &conds, SetCondVec &condVec, LitVec &condSyms);
 	virtual void printAggr(const AggrTodoKey &key, const AggrTodoVal &val, SetCondVec &condVec) = 0;
+	virtual uint32_t aggrSymbol(const AggrTodoKey &key);
+	virtual void extend();
 	LparseConverter *output() const;
+	AggrCondPrinter *condPrinter() const;
 	std::ostream &out() const;
 	void finish();
 
@@ -138,12 +148,53 @@ private:
 
 class SumAggrLitPrinter : public AggrLitPrinter<SumAggrLit>
 {
+	//! an element of an extensible aggregate together with the conditions printed so far
+	struct Element
+	{
+		Element();
+
+		Cond::HeadLitsVec lits;
+		LitVec            syms;
+		bool              fact;
+	};
+	typedef boost::unordered_map<ValVec, Element> ElementMap;
+	/**
+	 * An aggregate printed in an incremental program that can still receive
+	 * elements in later steps. The open contribution of later steps is
+	 * represented by chains of frozen atoms where the i-th atom holds if the
+	 * elements added later sum up to at least i+1.
+	 */
+	struct Extension
+	{
+		Extension(const AggrTodoKey &key, uint32_t symbol);
+		//! whether later elements cannot change the aggregate anymore
+		bool closed() const;
+
+		AggrTodoKey key;
+		uint32_t    symbol;
+		AtomVec     lower;
+		AtomVec     upper;
+		ElementMap  elems;
+		bool        dirty;
+	};
+	typedef boost::unordered_map<State, Extension> ExtensionMap;
 public:
 	SumAggrLitPrinter(LparseConverter *output);
 	static void combine(SetCondVec::value_type &a, const SetCondVec::value_type &b);
 	static bool analyze(const SetCondVec::value_type &a, int64_t &min, int64_t &max, int64_t &fix);
 	void printSum(uint32_t sym, int64_t bound, LitVec &conds, SetCondVec &condVec);
+	void printWeight(uint32_t sym, int64_t bound, const WeightLitVec &lits);
 	void printAggr(const AggrTodoKey &key, const AggrTodoVal &val, SetCondVec &condVec);
+	uint32_t aggrSymbol(const AggrTodoKey &key);
+	void extend();
+private:
+	bool printExtensible(const AggrTodoKey &key, const AggrTodoVal &val, SetCondVec &condVec);
+	bool openChain(int64_t bound, AtomVec &chain);
+	void extendChain(AtomVec &chain, int64_t fix, const WeightLitVec &lits);
+	void close(Extension &ext);
+	int32_t condSym(const Cond::HeadLitsVec &lits);
+private:
+	ExtensionMap ext_;
 };
 
 template <uint32_t Type>
@@ -177,6 +228,7 @@ inline void AggrCondPrinter::trueLit() { }
 inline LparseConverter *AggrCondPrinter::output() const { return output_; }
 //inline std::ostream &AggrCondPrinter::out() const { return output_->out(); }
 inline void AggrCondPrinter::end() { }
+inline void AggrCondPrinter::takeChanged(StateVec &states) { states.clear(); states.swap(changed_); }
 
 //////////////////////////////// AggrBoundCheck ////////////////////////////////
 
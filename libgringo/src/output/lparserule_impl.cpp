@@ -39,9 +39,10 @@ void RulePrinter::endHead()
 
 void RulePrinter::end()
 {
+	if(head_.empty() && !choice_) { head_.push_back(1); }
+	if(!output_->simplifyRule(head_, pos_, neg_, choice_)) { return; }
 	if(choice_)               { if (!head_.empty()) { output_->printChoiceRule(head_, pos_, neg_); } }
 	else if(head_.size() > 1) { output_->printDisjunctiveRule(head_, pos_, neg_); }
-	else if(head_.empty())    { output_->printBasicRule(1, pos_, neg_); }
 	else                      { output_->printBasicRule(head_[0], pos_, neg_); }
 }
 
@@ -234,6 +234,7 @@ line ::= rule(r).                                      { pParser->add(r); }
 line ::= DOMAIN signed(id) LBRAC var_list(vars) RBRAC. { pParser->domainStm(id.loc(), id.index, *vars); del(vars); }
 line ::= EXTERNAL(tok) predicate(pred) cond(list).     { pParser->add(new External(tok.loc(), pred, *list)); delete list; }
 line ::= EXTERNAL signed(id) SLASH NUMBER(num).        { GRD->externalStm(id.index, num.number); }
+line ::= SQL signed(id) SLASH NUMBER(num) COLON STRING(db) COLON STRING(table). { GRD->sqlStm(id.loc(), id.index, num.number, db.index, table.index); }
 line ::= CUMULATIVE IDENTIFIER(id).                    { pParser->incremental(Parser::IPART_CUMULATIVE, id.index); }
 line ::= VOLATILE IDENTIFIER(id).                      { pParser->incremental(Parser::IPART_VOLATILE, id.index); }
 line ::= VOLATILE IDENTIFIER(id) COLON term(term).     { if(pParser->checkVolTerm(term)) pParser->incremental(Parser::IPART_VOLATILE, id.index, term->val(GRD).number()); }
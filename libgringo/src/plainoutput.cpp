@@ -60,6 +60,7 @@ void DelayedOutput::Line::clear()
 DelayedOutput::DelayedOutput(std::ostream &out)
 	: curLine_(0)
 	, out_(out)
+	, bufStream_(&buf_)
 	, lines_(1)
 {
 }
@@ -68,8 +69,8 @@ DelayedOutput::Offset DelayedOutput::beginDelay()
 {
 	Line &line = lines_[curLine_];
 	uint32_t d = line.slices.size();
-	line.slices.push_back(buf_.str());
-	buf_.str("");
+	line.slices.push_back(std::string());
+	buf_.take(line.slices.back());
 	return Offset(curLine_, d);
 }
 
@@ -77,7 +78,7 @@ void DelayedOutput::contDelay(const Offset &idx)
 {
 	Line &line = lines_[idx.first];
 	line.slices[idx.second] += buf_.str();
-	buf_.str("");
+	buf_.clear();
 }
 
 void DelayedOutput::endDelay(const Offset &idx)
@@ -114,11 +115,13 @@ void DelayedOutput::endLine()
 		if(line.cb.empty()) { out_ << buf_.str(); }
 		else                { line.cb(buf_.str()); }
 		line.clear();
+		buf_.clear();
 	}
 	else
 	{
 		line.finished++;
-		line.slices.push_back(buf_.str());
+		line.slices.push_back(std::string());
+		buf_.take(line.slices.back());
 		if(free_.empty())
 		{
 			curLine_ = lines_.size();
@@ -130,11 +133,10 @@ void DelayedOutput::endLine()
 			free_.pop_back();
 		}
 	}
-	buf_.str("");
 }
 
-std::ostream &DelayedOutput::buffer() { return buf_; }
-std::ostream &DelayedOutput::output() { return out_; }
+std::ostream &DelayedOutput::buffer() { return bufStream_; }
+Writer &DelayedOutput::output()       { return out_; }
 
 ////////////////////////////////// PlainOutput //////////////////////////////////
 
@@ -262,6 +264,7 @@ void PlainOutput::finalize()
 		out_.output() << "}.\n";
 		compute_.str("");
 	}
+	out_.output().flush();
 }
 
 void PlainOutput::doHideAll()
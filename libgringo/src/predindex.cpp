@@ -70,6 +70,7 @@ bool PredIndex::extend(Grounder *grounder, ValVec::const_iterator vals)
 			sets_.push_back(BindSet());
 			indexVec_.resize(indexVec_.size() + index_.size());
 		}
+		else if(mark_.marked && res.first->second < mark_.sets) { mark_.touched.push_back(res.first->second); }
 		sets_[res.first->second].push_back(bindVec_.size());
 		// TODO: the easiest way is to push in dummy values here
 		//       maybe there is a better way
@@ -143,3 +144,30 @@ bool PredIndex::init(Grounder *g)
 	dom_->extend(g, this, lastExtend_);
 	return hasNew();
 }
+
+void PredIndex::mark(Domain *)
+{
+	assert(!mark_.marked);
+	mark_.marked = true;
+	mark_.sets   = sets_.size();
+	mark_.binds  = bindVec_.size();
+}
+
+void PredIndex::rollback(Domain *dom)
+{
+	assert(mark_.marked);
+	uint32_t n = index_.size();
+	// the keys of the sets created after the mark are stored after the keys of the older sets
+	for(uint32_t i = mark_.sets; i < sets_.size(); i++) { map_.erase(i * n); }
+	sets_.resize(mark_.sets);
+	indexVec_.resize((mark_.sets + 1) * n);
+	foreach(uint32_t i, mark_.touched)
+	{
+		BindSet &set = sets_[i];
+		while(!set.empty() && set.back() >= mark_.binds) { set.pop_back(); }
+	}
+	bindVec_.resize(mark_.binds);
+	finished_   = std::min(finished_, mark_.binds);
+	lastExtend_ = dom->size();
+	mark_       = Mark();
+}
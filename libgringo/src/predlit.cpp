@@ -24,6 +24,19 @@
 #include "gringo/formula.h"
 #include "gringo/instantiator.h"
 #include "gringo/litdep.h"
+#include "gringo/sqlsource.h"
+#include "gringo/exceptions.h"
+
+namespace
+{
+	//! the table is the only source of atoms of a #sql predicate, derived ones would not be found
+	void derivedSqlAtom(Grounder *g, const PredLit *lit)
+	{
+		std::ostringstream oss;
+		lit->print(g, oss);
+		throw TypeException("atoms of a #sql predicate cannot be derived", StrLoc(g, lit->loc()), oss.str());
+	}
+}
 
 Lit::Score BasicBodyOrderHeuristic::score(Grounder *, VarSet &bound, PredLit *pred)
 {
@@ -57,6 +70,28 @@ Lit::Score UnifyBodyOrderHeuristic::score(Grounder *g, VarSet &bound, PredLit *p
 	return Lit::Score(pred->complete() ? Lit::NON_RECURSIVE : Lit::RECURSIVE, varDoms.map.empty() ? 0 : tsum / varDoms.map.size());
 }
 
+Lit::Score CostBodyOrderHeuristic::score(Grounder *, VarSet &bound, PredLit *pred)
+{
+	// assuming uniformly distributed values, each bound argument
+	// divides the number of matching atoms by its number of distinct values
+	double cost = pred->dom()->size();
+	VarSet curBound(bound);
+	for(size_t i = 0; i < pred->terms().size(); i++)
+	{
+		VarSet vars;
+		pred->terms()[i].vars(vars);
+		VarVec diff;
+		std::set_difference(vars.begin(), vars.end(), curBound.begin(), curBound.end(), std::back_inserter(diff));
+		if(diff.size() < vars.size() || vars.empty())
+		{
+			double distinct = std::max<uint32_t>(1, pred->dom()->distinct(i));
+			cost /= vars.empty() ? distinct : std::pow(distinct, 1.0 - diff.size() / (double)vars.size());
+		}
+		curBound.insert(vars.begin(), vars.end());
+	}
+	return Lit::Score(pred->complete() ? Lit::NON_RECURSIVE : Lit::RECURSIVE, cost);
+}
+
 PredLit::PredLit(const Loc &loc, Domain *dom, TermPtrVec &terms)
 	: Lit(loc)
 	, PredLitRep(false, dom)
@@ -101,14 +136,16 @@ bool PredLit::match(Grounder *grounder)
 	vals_.resize(top_);
 	foreach(const Term &term, terms_) { vals_.push_back(term.val(grounder)); }
 	if(head())            { return true; }
+	if(dom_->source())    { dom_->source()->fetch(grounder, dom_, vals_.begin() + top_); }
 	if(sign())            { return !dom_->find(vals_.begin() + top_).fact; }
 	if(dom()->external()) { return true; }
 	else                  { return dom_->find(vals_.begin() + top_).valid(); }
 }
 
-Index *PredLit::index(Grounder *, Formula *gr, VarSet &bound)
+Index *PredLit::index(Grounder *g, Formula *gr, VarSet &bound)
 {
 	parent_ = gr;
+	if(head() && dom_->source()) { derivedSqlAtom(g, this); }
 	if(sign() || head() || dom()->external())
 	{
 		index_ = 0;
@@ -122,6 +159,12 @@ Index *PredLit::index(Grounder *, Formula *gr, VarSet &bound)
 		std::set_intersection(bound.begin(), bound.end(), vars.begin(), vars.end(), std::back_insert_iterator<VarVec>(index));
 		std::set_difference(vars.begin(), vars.end(), index.begin(), index.end(), std::back_insert_iterator<VarVec>(bind));
 		bound.insert(vars.begin(), vars.end());
+		if(dom_->source())
+		{
+			// the table is queried instead of the domain
+			index_ = 0;
+			return dom_->source()->index(g, this, bind);
+		}
 		index_ = new PredIndex(dom_, terms_, index, bind);
 		return index_;
 	}
@@ -220,6 +263,8 @@ void PredLit::provide(PredLit *pred)
 
 void PredLit::addDomain(Grounder *g, bool fact)
 {
+	// facts are added without an index
+	if(dom_->source()) { derivedSqlAtom(g, this); }
 	bool res = PredLitRep::addDomain(g, fact);
 	if(res && !startNew_) { startNew_ = dom_->size(); }
 }
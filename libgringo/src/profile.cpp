@@ -0,0 +1,212 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gringo/profile.h>
+#include <gringo/formula.h>
+#include <gringo/instantiator.h>
+#include <gringo/grounder.h>
+#include <gringo/domain.h>
+#include <gringo/exceptions.h>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <iomanip>
+
+namespace
+{
+	struct Row
+	{
+		Row(Grounder *g, const Formula *f, const Profile::Entry *e)
+			: loc(g, f->loc())
+			, entry(e)
+		{
+			std::ostringstream oss;
+			f->print(g, oss);
+			text = oss.str();
+		}
+		StrLoc                 loc;
+		std::string            text;
+		const Profile::Entry *entry;
+	};
+
+	bool before(const Row &a, const Row &b)
+	{
+		if(a.loc.file != b.loc.file) { return a.loc.file < b.loc.file; }
+		if(a.loc.line != b.loc.line) { return a.loc.line < b.loc.line; }
+		if(a.loc.column != b.loc.column) { return a.loc.column < b.loc.column; }
+		return a.text < b.text;
+	}
+
+	bool slower(const Row &a, const Row &b)
+	{
+		return a.entry->time > b.entry->time;
+	}
+
+	bool smaller(Domain *a, Domain *b)
+	{
+		if(a->nameId() != b->nameId()) { return a->nameId() < b->nameId(); }
+		return a->arity() < b->arity();
+	}
+
+	std::string quote(const std::string &str)
+	{
+		std::string ret("\"");
+		foreach(char c, str)
+		{
+			if(c == '"') { ret.push_back('"'); }
+			ret.push_back(c);
+		}
+		ret.push_back('"');
+		return ret;
+	}
+
+	void rows(Grounder *g, const Profile::EntryMap &entries, std::vector<Row> &rows)
+	{
+		foreach(const Profile::EntryMap::value_type &ref, entries) { rows.push_back(Row(g, ref.first, &ref.second)); }
+		// NOTE: the map is ordered by address, which differs from run to run
+		std::sort(rows.begin(), rows.end(), before);
+	}
+
+	void domains(Grounder *g, std::vector<Domain*> &doms)
+	{
+		foreach(Domain *dom, g->domains()) { doms.push_back(dom); }
+		std::sort(doms.begin(), doms.end(), smaller);
+	}
+}
+
+Profile::Entry::Entry()
+	: time(0)
+	, grounded(0)
+	, enqueued(0)
+	, probes(0)
+	, matches(0)
+	, instances(0)
+{
+}
+
+void Profile::Entry::add(const Entry &e)
+{
+	time      += e.time;
+	grounded  += e.grounded;
+	enqueued  += e.enqueued;
+	probes    += e.probes;
+	matches   += e.matches;
+	instances += e.instances;
+}
+
+double Profile::now()
+{
+	static const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+	return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() * 1e-6;
+}
+
+void Profile::enqueued(const Formula *stm)
+{
+	entries_[stm].enqueued++;
+}
+
+void Profile::grounded(const Formula *stm, Instantiator *inst, double time)
+{
+	Entry &entry = entries_[stm];
+	entry.time += time;
+	entry.grounded++;
+	if(inst)
+	{
+		Instantiator::Counters &counters = inst->counters();
+		entry.probes    += counters.probes;
+		entry.matches   += counters.matches;
+		entry.instances += counters.instances;
+		counters = Instantiator::Counters();
+	}
+	else { entry.instances++; }
+}
+
+void Profile::fact(const Formula *stm)
+{
+	EntryMap::iterator it = entries_.find(stm);
+	if(it != entries_.end())
+	{
+		facts_.add(it->second);
+		entries_.erase(it);
+	}
+}
+
+void Profile::print(Grounder *g, std::ostream &out) const
+{
+	std::vector<Row> entries;
+	rows(g, entries_, entries);
+	std::stable_sort(entries.begin(), entries.end(), slower);
+
+	out << std::setiosflags(std::ios::right) << std::resetiosflags(std::ios::left);
+	out << "=== Grounding Statistics ===" << std::endl;
+	out << std::setw(9) << "time" << std::setw(8) << "queued" << std::setw(12) << "probes" << std::setw(12) << "matches" << std::setw(12) << "instances" << "  statement" << std::endl;
+	foreach(const Row &row, entries)
+	{
+		const Entry &e = *row.entry;
+		out << std::setw(9) << std::fixed << std::setprecision(3) << e.time
+		    << std::setw(8) << e.enqueued
+		    << std::setw(12) << e.probes
+		    << std::setw(12) << e.matches
+		    << std::setw(12) << e.instances
+		    << "  " << row.loc << ": " << row.text << std::endl;
+	}
+	if(facts_.grounded > 0)
+	{
+		out << std::setw(9) << std::fixed << std::setprecision(3) << facts_.time
+		    << std::setw(8) << facts_.enqueued
+		    << std::setw(12) << facts_.probes
+		    << std::setw(12) << facts_.matches
+		    << std::setw(12) << facts_.instances
+		    << "  (facts)" << std::endl;
+	}
+	out << std::endl;
+
+	std::vector<Domain*> doms;
+	domains(g, doms);
+	out << std::setw(9) << "atoms" << std::setw(12) << "inserts" << "  predicate" << std::endl;
+	foreach(Domain *dom, doms)
+	{
+		out << std::setw(9) << dom->size() << std::setw(12) << dom->inserts() << "  " << g->string(dom->nameId()) << "/" << dom->arity() << std::endl;
+	}
+	out << std::endl;
+}
+
+void Profile::dump(Grounder *g, std::ostream &out) const
+{
+	std::vector<Row> entries;
+	rows(g, entries_, entries);
+	// NOTE: the name comes last because it may contain commas
+	out << "kind,file,line,column,time,grounded,enqueued,probes,matches,instances,atoms,inserts,name" << std::endl;
+	foreach(const Row &row, entries)
+	{
+		const Entry &e = *row.entry;
+		out << "statement," << quote(row.loc.file) << "," << row.loc.line << "," << row.loc.column << ","
+		    << e.time << "," << e.grounded << "," << e.enqueued << "," << e.probes << "," << e.matches << "," << e.instances << ",,,"
+		    << quote(row.text) << std::endl;
+	}
+	if(facts_.grounded > 0)
+	{
+		out << "facts,,,," << facts_.time << "," << facts_.grounded << "," << facts_.enqueued << "," << facts_.probes << "," << facts_.matches << "," << facts_.instances << ",,,"
+		    << quote("(facts)") << std::endl;
+	}
+	std::vector<Domain*> doms;
+	domains(g, doms);
+	foreach(Domain *dom, doms)
+	{
+		std::ostringstream oss;
+		oss << g->string(dom->nameId()) << "/" << dom->arity();
+		out << "predicate,,,,,,,,,," << dom->size() << "," << dom->inserts() << "," << quote(oss.str()) << std::endl;
+	}
+}
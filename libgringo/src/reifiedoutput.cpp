@@ -40,41 +40,50 @@ GRINGO_EXPORT_PRINTER(ComputePrinter)
 
 }
 
-ReifiedOutput::Node::Node(size_t symbol)
-	: symbol_(symbol)
-	, visited_(0)
-	, finished_(1)
+template <class T>
+ReifiedOutput::SeqStore<T>::SeqStore()
+	: offsets_(1, 0)
 { }
-size_t ReifiedOutput::Node::symbol() const { return symbol_; }
-void ReifiedOutput::Node::visit(size_t visited) { visited_ = visited + 1; }
-uint32_t ReifiedOutput::Node::visited() const { return visited_ - 1; }
-void ReifiedOutput::Node::mark() { visited_ = 1; }
-bool ReifiedOutput::Node::marked() const { return visited_ >= 1; }
-void ReifiedOutput::Node::pop() { finished_ = 0; }
-bool ReifiedOutput::Node::popped() const { return finished_ == 0; }
 
-ReifiedOutput::Node *ReifiedOutput::Node::next()
+template <class T>
+std::pair<uint32_t, bool> ReifiedOutput::SeqStore<T>::insert(const Seq &seq)
 {
-	while(finished_ - 1 < children.size())
+	size_t hash = boost::hash_range(seq.begin(), seq.end());
+	if(2 * (size() + 1) > table_.size()) { grow(); }
+	size_t mask = table_.size() - 1;
+	for(size_t i = hash & mask; ; i = (i + 1) & mask)
 	{
-		ReifiedOutput::Node *next = children[finished_++ - 1];
-		if(!next->marked()) { return next; }
+		uint32_t &slot = table_[i];
+		if(slot == 0)
+		{
+			elems_.insert(elems_.end(), seq.begin(), seq.end());
+			offsets_.push_back(elems_.size());
+			hashes_.push_back(hash);
+			slot = size();
+			return std::make_pair(slot - 1, true);
+		}
+		if(hashes_[slot - 1] == hash && equal(slot - 1, seq)) { return std::make_pair(slot - 1, false); }
 	}
-	return 0;
 }
 
-bool ReifiedOutput::Node::root()
+template <class T>
+bool ReifiedOutput::SeqStore<T>::equal(uint32_t i, const Seq &seq) const
+{
+	return offsets_[i + 1] - offsets_[i] == seq.size() && std::equal(seq.begin(), seq.end(), elems_.begin() + offsets_[i]);
+}
+
+template <class T>
+void ReifiedOutput::SeqStore<T>::grow()
 {
-	bool root = true;
-	foreach(ReifiedOutput::Node* node, children)
+	std::vector<uint32_t> table(std::max<size_t>(64, 2 * table_.size()), 0);
+	size_t mask = table.size() - 1;
+	for(uint32_t j = 0; j < size(); j++)
 	{
-		if(!node->popped() && node->visited() < visited())
-		{
-			root = false;
-			visit(node->visited());
-		}
+		size_t i = hashes_[j] & mask;
+		while(table[i] != 0) { i = (i + 1) & mask; }
+		table[i] = j + 1;
 	}
-	return root;
+	table_.swap(table);
 }
 
 ReifiedOutput::ReifiedOutput(std::ostream &out)
@@ -99,8 +108,8 @@ uint32_t ReifiedOutput::addSet()
 	Set &back = setStack_.back();
 	std::sort(back.begin(), back.end());
 	back.erase(std::unique(back.begin(), back.end()), back.end());
-	std::pair<SetMap::iterator, bool> res = sets_.insert(SetMap::value_type(back, sets_.size()));
-	uint32_t index = res.first->second;
+	std::pair<uint32_t, bool> res = sets_.insert(back);
+	uint32_t index = res.first;
 	if(res.second)
 	{
 		foreach(size_t sym, back)
@@ -141,8 +150,8 @@ uint32_t ReifiedOutput::addList()
 {
 	List &back = listStack_.back();
 	std::sort(back.begin(), back.end(), cmp);
-	std::pair<ListMap::iterator, bool> res = lists_.insert(ListMap::value_type(back, lists_.size()));
-	uint32_t index = res.first->second;
+	std::pair<uint32_t, bool> res = lists_.insert(back);
+	uint32_t index = res.first;
 	if(res.second)
 	{
 		uint32_t i = 0;
@@ -172,14 +181,7 @@ void ReifiedOutput::addDep()
 	assert(dep_.size() > 1);
 	foreach(const size_t &head, *(dep_.end() - 2))
 	{
-		Graph::iterator headIt = graph_.find(head);
-		if(headIt == graph_.end()) { headIt = graph_.insert(Graph::value_type(head, Node(head))).first; }
-		foreach(const size_t &body, dep_.back())
-		{
-			Graph::iterator bodyIt = graph_.find(body);
-			if(bodyIt == graph_.end()) { bodyIt = graph_.insert(Graph::value_type(body, Node(body))).first; }
-			headIt->second.children.push_back(&bodyIt->second);
-		}
+		foreach(const size_t &body, dep_.back()) { edges_.push_back(EdgeVec::value_type(head, body)); }
 	}
 }
 
@@ -199,11 +201,11 @@ size_t ReifiedOutput::symbol(PredLitRep *pred)
 	Val val;
 	if(pred->dom()->arity() > 0)
 	{
-		val = Val::func(storage()->index(Func(storage(), pred->dom()->nameId(), ValVec(pred->vals().begin(), pred->vals().end()))));
+		val = Val::func(storage()->index(pred->dom()->nameId(), ValVec(pred->vals().begin(), pred->vals().end())));
 	}
 	else { val = Val::id(pred->dom()->nameId()); }
-	val = Val::func(storage()->index(Func(storage(), storage()->index("atom"), ValVec(1, val))));
-	val = Val::func(storage()->index(Func(storage(), storage()->index(pred->sign() ? "neg" : "pos"), ValVec(1, val))));
+	val = Val::func(storage()->index(storage()->index("atom"), ValVec(1, val)));
+	val = Val::func(storage()->index(storage()->index(pred->sign() ? "neg" : "pos"), ValVec(1, val)));
 	return symbol(val);
 }
 
@@ -215,57 +217,70 @@ void ReifiedOutput::minimize(size_t sym, int weight, int prio)
 
 void ReifiedOutput::tarjan()
 {
-	uint32_t scc = 0;
-	std::vector<Node*> s;
-	std::vector<Node*> t;
+	// compressed adjacency lists: the successors of node i are edges[offsets[i]..offsets[i+1])
+	uint32_t nodes = symbols_.size();
+	std::vector<uint32_t> offsets(nodes + 1, 0);
+	foreach(const EdgeVec::value_type &edge, edges_) { offsets[edge.first + 1]++; }
+	for(uint32_t i = 0; i < nodes; i++) { offsets[i + 1] += offsets[i]; }
+	std::vector<uint32_t> edges(edges_.size());
+	{
+		std::vector<uint32_t> pos(offsets.begin(), offsets.end() - 1);
+		foreach(const EdgeVec::value_type &edge, edges_) { edges[pos[edge.first]++] = edge.second; }
+	}
+	EdgeVec().swap(edges_);
 
-	foreach(Graph::reference ref, graph_)
+	// iterative tarjan; index 0 marks unvisited nodes and DONE nodes assigned to a component
+	const uint32_t DONE = std::numeric_limits<uint32_t>::max();
+	std::vector<uint32_t> index(nodes, 0), low(nodes, 0);
+	std::vector<std::pair<uint32_t, uint32_t> > call;
+	std::vector<uint32_t> t;
+	uint32_t visited = 0;
+	uint32_t scc = 0;
+	for(uint32_t root = 0; root < nodes; root++)
 	{
-		if(!ref.second.popped())
+		if(index[root] != 0 || offsets[root] == offsets[root + 1]) { continue; }
+		index[root] = low[root] = ++visited;
+		t.push_back(root);
+		call.push_back(std::make_pair(root, offsets[root]));
+		while(!call.empty())
 		{
-			uint32_t visited = 0;
-			s.push_back(&ref.second);
-			ref.second.mark();
-
-			while(!s.empty())
+			uint32_t x = call.back().first;
+			if(call.back().second < offsets[x + 1])
 			{
-				Node *x = s.back();
-				if(x->visited() == 0)
+				uint32_t y = edges[call.back().second++];
+				if(index[y] == 0)
 				{
-					visited++;
-					x->visit(visited);
-					t.push_back(x);
+					index[y] = low[y] = ++visited;
+					t.push_back(y);
+					call.push_back(std::make_pair(y, offsets[y]));
 				}
-				Node *y = x->next();
-				if(y != 0)
-				{
-					s.push_back(y);
-					y->mark();
-				}
-				else
+				else if(index[y] != DONE) { low[x] = std::min(low[x], index[y]); }
+			}
+			else
+			{
+				call.pop_back();
+				if(!call.empty()) { low[call.back().first] = std::min(low[call.back().first], low[x]); }
+				if(low[x] == index[x])
 				{
-					s.pop_back();
-					if(x->root())
+					if(t.back() != x)
 					{
-						if(t.back() != x)
-						{
-							do
-							{
-								y = t.back();
-								t.pop_back();
-								y->pop();
-								out() << "scc(" << scc << ",";
-								val(y->symbol()).print(storage(), out());
-								out() << ").\n";
-							}
-							while(y != x);
-							scc++;
-						}
-						else
+						uint32_t y;
+						do
 						{
+							y = t.back();
 							t.pop_back();
-							x->pop();
+							index[y] = DONE;
+							out() << "scc(" << scc << ",";
+							val(y).print(storage(), out());
+							out() << ").\n";
 						}
+						while(y != x);
+						scc++;
+					}
+					else
+					{
+						t.pop_back();
+						index[x] = DONE;
 					}
 				}
 			}
@@ -0,0 +1,198 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gringo/snapshot.h>
+#include <gringo/grounder.h>
+#include <gringo/domain.h>
+#include <gringo/lparseconverter.h>
+
+namespace
+{
+	const uint32_t MAGIC   = 0x4e534747;
+	const uint32_t VERSION = 1;
+
+	class Writer
+	{
+	public:
+		Writer(std::ostream &out) : out_(out) { }
+		void word(uint32_t x)
+		{
+			char buf[4] = { char(x), char(x >> 8), char(x >> 16), char(x >> 24) };
+			out_.write(buf, 4);
+		}
+		void val(const Val &v)
+		{
+			word(v.type);
+			word(v.index);
+		}
+		void str(const std::string &s)
+		{
+			static const char pad[4] = { 0, 0, 0, 0 };
+			word(s.size());
+			out_.write(s.data(), s.size());
+			out_.write(pad, (4 - s.size() % 4) % 4);
+		}
+	private:
+		std::ostream &out_;
+	};
+
+	class Reader
+	{
+	public:
+		Reader(std::istream &in) : in_(in) { }
+		uint32_t word()
+		{
+			unsigned char buf[4];
+			if(!in_.read(reinterpret_cast<char*>(buf), 4)) { throw std::runtime_error("snapshot: unexpected end of file"); }
+			return uint32_t(buf[0]) | (uint32_t(buf[1]) << 8) | (uint32_t(buf[2]) << 16) | (uint32_t(buf[3]) << 24);
+		}
+		std::string str()
+		{
+			uint32_t size = word();
+			std::string s(size, '\0');
+			char pad[4];
+			if(!in_.read(&s[0], size) || !in_.read(pad, (4 - size % 4) % 4)) { throw std::runtime_error("snapshot: unexpected end of file"); }
+			return s;
+		}
+		uint32_t index(const VarVec &map)
+		{
+			uint32_t i = word();
+			if(i >= map.size()) { throw std::runtime_error("snapshot: invalid index"); }
+			return map[i];
+		}
+		Val val(const VarVec &strings, const VarVec &funcs)
+		{
+			uint32_t type = word();
+			switch(type)
+			{
+				case Val::NUM:    return Val::number(int32_t(word()));
+				case Val::ID:     return Val::id(index(strings));
+				case Val::STRING: return Val::string(index(strings));
+				case Val::FUNC:   return Val::func(index(funcs));
+				case Val::INF:    word(); return Val::inf();
+				case Val::SUP:    word(); return Val::sup();
+				case Val::UNDEF:  word(); return Val::undef();
+				case Val::FAIL:   word(); return Val::fail();
+			}
+			throw std::runtime_error("snapshot: invalid value");
+		}
+	private:
+		std::istream &in_;
+	};
+}
+
+void Snapshot::save(std::ostream &out, Grounder *g, LparseConverter *conv, int step)
+{
+	Writer w(out);
+	w.word(MAGIC);
+	w.word(VERSION);
+	w.word(step);
+	// function terms only refer to strings and earlier function terms
+	w.word(g->numStrings());
+	for(uint32_t i = 0; i < g->numStrings(); i++) { w.str(g->string(i)); }
+	w.word(g->numFuncs());
+	for(uint32_t i = 0; i < g->numFuncs(); i++)
+	{
+		const Func &f = g->func(i);
+		w.word(f.name());
+		w.word(f.args().size());
+		foreach(const Val &v, f.args()) { w.val(v); }
+	}
+	w.word(g->domains().size());
+	foreach(Domain *dom, g->domains())
+	{
+		w.word(dom->nameId());
+		w.word(dom->arity());
+		w.word(dom->external());
+		w.word(dom->size());
+		for(uint32_t i = 0; i < dom->size(); i++)
+		{
+			w.word(dom->find(dom->vals(i)).fact);
+			for(ValVec::const_iterator it = dom->vals(i), end = it + dom->arity(); it != end; ++it) { w.val(*it); }
+		}
+	}
+	if(conv)
+	{
+		w.word(conv->symbols().size());
+		foreach(const LparseConverter::Symbol &sym, conv->symbols())
+		{
+			w.word(sym.symbol);
+			w.word(sym.external);
+			w.word(sym.repr.first);
+			w.word(sym.repr.second.size());
+			foreach(const Val &v, sym.repr.second) { w.val(v); }
+		}
+		w.word(conv->nextSymbol());
+	}
+	else
+	{
+		w.word(0);
+		w.word(0);
+	}
+	if(!out) { throw std::runtime_error("snapshot: could not write state"); }
+}
+
+int Snapshot::load(std::istream &in, Grounder *g, LparseConverter *conv)
+{
+	Reader r(in);
+	if(r.word() != MAGIC || r.word() != VERSION) { throw std::runtime_error("snapshot: invalid state file"); }
+	int step = int32_t(r.word());
+	VarVec strings(r.word());
+	foreach(uint32_t &i, strings) { i = g->index(r.str()); }
+	VarVec funcs(r.word());
+	ValVec args;
+	foreach(uint32_t &i, funcs)
+	{
+		uint32_t name = r.index(strings);
+		args.resize(r.word());
+		foreach(Val &v, args) { v = r.val(strings, funcs); }
+		i = g->index(name, args);
+	}
+	VarVec doms(r.word());
+	ValVec vals;
+	foreach(uint32_t &i, doms)
+	{
+		uint32_t nameId   = r.index(strings);
+		uint32_t arity    = r.word();
+		bool     external = r.word();
+		Domain  *dom      = g->newDomain(nameId, arity);
+		if(external) { dom->external(true); }
+		vals.resize(arity);
+		for(uint32_t size = r.word(); size > 0; size--)
+		{
+			bool fact = r.word();
+			foreach(Val &v, vals) { v = r.val(strings, funcs); }
+			dom->insert(g, vals.begin(), fact);
+		}
+		i = dom->domId();
+	}
+	// indices of the statements are filled from the restored domains when they are initialized
+	for(uint32_t size = r.word(); size > 0; size--)
+	{
+		uint32_t symbol   = r.word();
+		bool     external = r.word();
+		LparseConverter::Symbol::Repr repr;
+		repr.first = r.index(doms);
+		repr.second.resize(r.word());
+		foreach(Val &v, repr.second) { v = r.val(strings, funcs); }
+		if(conv) { conv->restoreSymbol(repr, symbol, external); }
+	}
+	uint32_t next = r.word();
+	if(conv && next > 0) { conv->nextSymbol(next); }
+	return step;
+}
@@ -0,0 +1,285 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <gringo/sqlsource.h>
+#include <gringo/grounder.h>
+#include <gringo/domain.h>
+#include <gringo/predlit.h>
+#include <gringo/index.h>
+#include <gringo/term.h>
+#include <gringo/exceptions.h>
+
+#ifdef WITH_SQLITE3
+
+#include <sqlite3.h>
+
+namespace
+{
+	//! quotes an sql identifier; embedded quotes are doubled
+	std::string quote(const std::string &name)
+	{
+		std::string res("\"");
+		foreach(char c, name)
+		{
+			if(c == '"') { res+= '"'; }
+			res+= c;
+		}
+		return res + '"';
+	}
+}
+
+// ========================== SqlSource::Query ==========================
+
+//! a prepared statement with parameters for some of the columns
+class SqlSource::Query
+{
+public:
+	Query(SqlSource *source, const std::vector<bool> &pushed);
+	//! starts a query with the given arguments (only the pushed ones are used)
+	bool bind(Grounder *g, const ValVec &args);
+	//! decodes the next row into row
+	bool next(Grounder *g, ValVec &row);
+	bool pushed(uint32_t i) const { return pushed_[i]; }
+	~Query();
+private:
+	SqlSource        *source_;
+	std::vector<bool> pushed_;
+	sqlite3_stmt     *stm_;
+};
+
+SqlSource::Query::Query(SqlSource *source, const std::vector<bool> &pushed)
+	: source_(source)
+	, pushed_(pushed)
+	, stm_(source->prepare(pushed))
+{
+}
+
+bool SqlSource::Query::bind(Grounder *g, const ValVec &args)
+{
+	sqlite3_reset(stm_);
+	sqlite3_clear_bindings(stm_);
+	int param = 1;
+	for(uint32_t i = 0; i < pushed_.size(); i++)
+	{
+		if(!pushed_[i]) { continue; }
+		const Val &v = args[i];
+		int res;
+		if(v.type == Val::NUM)         { res = sqlite3_bind_int(stm_, param++, v.num); }
+		else if(v.type == Val::STRING)
+		{
+			const std::string &str = g->string(v.index);
+			res = sqlite3_bind_text(stm_, param++, str.c_str(), str.size(), SQLITE_STATIC);
+		}
+		// rows only contain numbers and strings
+		else { return false; }
+		if(res != SQLITE_OK) { source_->error(sqlite3_errmsg(source_->db_)); }
+	}
+	return true;
+}
+
+bool SqlSource::Query::next(Grounder *g, ValVec &row)
+{
+	for(;;)
+	{
+		int res = sqlite3_step(stm_);
+		if(res == SQLITE_DONE) { return false; }
+		if(res != SQLITE_ROW)  { source_->error(sqlite3_errmsg(source_->db_)); }
+		row.clear();
+		for(int i = 0; i < sqlite3_column_count(stm_); i++)
+		{
+			switch(sqlite3_column_type(stm_, i))
+			{
+				case SQLITE_INTEGER:
+				case SQLITE_FLOAT:
+				{
+					row.push_back(Val::number(sqlite3_column_int(stm_, i)));
+					break;
+				}
+				case SQLITE_TEXT:
+				case SQLITE_BLOB:
+				{
+					const char *text = reinterpret_cast<const char *>(sqlite3_column_text(stm_, i));
+					row.push_back(Val::string(g->index(std::string(text, sqlite3_column_bytes(stm_, i)))));
+					break;
+				}
+				default: { break; }
+			}
+		}
+		if(row.size() == pushed_.size()) { return true; }
+	}
+}
+
+SqlSource::Query::~Query()
+{
+	sqlite3_finalize(stm_);
+}
+
+// ========================== SqlIndex ==========================
+
+namespace
+{
+	class SqlIndex : public StaticIndex
+	{
+	public:
+		SqlIndex(SqlSource::Query *query, PredLit *pred, const VarVec &bind);
+		bool first(Grounder *grounder, int binder);
+		bool next(Grounder *grounder, int binder);
+	private:
+		std::auto_ptr<SqlSource::Query> query_;
+		PredLit                        *pred_;
+		VarVec                          bind_;
+		ValVec                          args_;
+		ValVec                          row_;
+	};
+
+	SqlIndex::SqlIndex(SqlSource::Query *query, PredLit *pred, const VarVec &bind)
+		: query_(query)
+		, pred_(pred)
+		, bind_(bind)
+	{
+	}
+
+	bool SqlIndex::first(Grounder *grounder, int binder)
+	{
+		args_.clear();
+		for(uint32_t i = 0; i < pred_->terms().size(); i++)
+		{
+			args_.push_back(query_->pushed(i) ? pred_->terms()[i].val(grounder) : Val::undef());
+		}
+		if(!query_->bind(grounder, args_)) { return false; }
+		return next(grounder, binder);
+	}
+
+	bool SqlIndex::next(Grounder *grounder, int binder)
+	{
+		while(query_->next(grounder, row_))
+		{
+			foreach(uint32_t var, bind_) { grounder->unbind(var); }
+			pred_->dom()->insert(grounder, row_.begin(), true);
+			bool unified = true;
+			ValVec::const_iterator val = row_.begin();
+			foreach(const Term &term, pred_->terms())
+			{
+				if(!term.unify(grounder, *val++, binder))
+				{
+					unified = false;
+					break;
+				}
+			}
+			if(unified) { return true; }
+		}
+		foreach(uint32_t var, bind_) { grounder->unbind(var); }
+		return false;
+	}
+}
+
+// ========================== SqlSource ==========================
+
+SqlSource::SqlSource(Grounder *g, const Loc &loc, const std::string &db, const std::string &table, uint32_t arity)
+	: loc_(loc)
+	, storage_(g)
+	, db_(0)
+	, table_(table)
+{
+	if(sqlite3_open_v2(db.c_str(), &db_, SQLITE_OPEN_READONLY, 0) != SQLITE_OK)
+	{
+		error(db_ ? sqlite3_errmsg(db_) : "could not open database");
+	}
+	// the column names are taken from the table
+	sqlite3_stmt *stm = 0;
+	std::string sql = "SELECT * FROM " + quote(table_);
+	if(sqlite3_prepare_v2(db_, sql.c_str(), -1, &stm, 0) != SQLITE_OK) { error(sqlite3_errmsg(db_)); }
+	for(int i = 0; i < sqlite3_column_count(stm); i++) { columns_.push_back(sqlite3_column_name(stm, i)); }
+	sqlite3_finalize(stm);
+	if(columns_.size() != arity)
+	{
+		std::ostringstream oss;
+		oss << "table has " << columns_.size() << " columns but the predicate has arity " << arity;
+		error(oss.str());
+	}
+	fetch_.reset(new Query(this, std::vector<bool>(arity, true)));
+}
+
+sqlite3_stmt *SqlSource::prepare(const std::vector<bool> &pushed)
+{
+	std::ostringstream sql;
+	sql << "SELECT * FROM " << quote(table_);
+	const char *sep = " WHERE ";
+	for(uint32_t i = 0; i < pushed.size(); i++)
+	{
+		if(!pushed[i]) { continue; }
+		sql << sep << quote(columns_[i]) << " = ?";
+		sep = " AND ";
+	}
+	sqlite3_stmt *stm = 0;
+	if(sqlite3_prepare_v2(db_, sql.str().c_str(), -1, &stm, 0) != SQLITE_OK) { error(sqlite3_errmsg(db_)); }
+	return stm;
+}
+
+Index *SqlSource::index(Grounder *, PredLit *pred, const VarVec &bind)
+{
+	// arguments without variables to bind are passed as parameters
+	std::vector<bool> pushed;
+	VarSet binds(bind.begin(), bind.end());
+	foreach(const Term &term, pred->terms())
+	{
+		VarSet vars;
+		term.vars(vars);
+		bool push = true;
+		foreach(uint32_t var, vars) { push = push && binds.find(var) == binds.end(); }
+		pushed.push_back(push);
+	}
+	return new SqlIndex(new Query(this, pushed), pred, bind);
+}
+
+void SqlSource::fetch(Grounder *g, Domain *dom, const ValVec::const_iterator &vals)
+{
+	if(dom->find(vals).valid()) { return; }
+	ValVec args(vals, vals + dom->arity()), row;
+	if(fetch_->bind(g, args) && fetch_->next(g, row)) { dom->insert(g, row.begin(), true); }
+}
+
+void SqlSource::error(const std::string &msg)
+{
+	std::ostringstream oss;
+	oss << "sql: " << msg << ":\n";
+	oss << "\t" << StrLoc(storage_, loc_) << ": " << table_;
+	throw std::runtime_error(oss.str());
+}
+
+SqlSource::~SqlSource()
+{
+	fetch_.reset(0);
+	if(db_) { sqlite3_close(db_); }
+}
+
+#else
+
+class SqlSource::Query { };
+
+SqlSource::SqlSource(Grounder *, const Loc &, const std::string &, const std::string &, uint32_t)
+	: db_(0)
+{
+	throw std::runtime_error("sql: gringo was build without sqlite3 support");
+}
+
+Index *SqlSource::index(Grounder *, PredLit *, const VarVec &) { return 0; }
+void SqlSource::fetch(Grounder *, Domain *, const ValVec::const_iterator &) { }
+SqlSource::~SqlSource() { }
+
+#endif
@@ -28,8 +28,65 @@ Storage::Storage(Output *output)
 
 uint32_t Storage::index(const Func &f)
 {
-	FuncSet::iterator it = funcs_.push_back(f).first;
-	return it - funcs_.begin();
+	return index(f.name(), f.args().begin(), f.args().end());
+}
+
+uint32_t Storage::index(uint32_t name, const ValVec &args)
+{
+	const Val *first = args.empty() ? 0 : &args[0];
+	return index(name, first, first + args.size());
+}
+
+uint32_t Storage::index(uint32_t name, const Val *first, const Val *last)
+{
+	size_t hash = Func::hash(name, first, last);
+	if(2 * (funcs_.size() + 1) > funcTable_.size()) { growFuncTable(); }
+	size_t mask = funcTable_.size() - 1;
+	for(size_t i = hash & mask; ; i = (i + 1) & mask)
+	{
+		uint32_t &slot = funcTable_[i];
+		if(slot == 0)
+		{
+			Func f(name, storeArgs(first, last), last - first, hash);
+			foreach(const Val &val, f.args())
+			{
+				if(val.type == Val::FUNC) { f.depth_ = std::max(f.depth_, funcs_[val.index].depth_ + 1); }
+			}
+			funcs_.push_back(f);
+			slot = funcs_.size();
+			return slot - 1;
+		}
+		const Func &f = funcs_[slot - 1];
+		if(f.hash() == hash && f.equal(name, first, last)) { return slot - 1; }
+	}
+}
+
+const Val *Storage::storeArgs(const Val *first, const Val *last)
+{
+	size_t size = last - first;
+	if(size == 0) { return 0; }
+	if(argBlocks_.empty() || argBlocks_.back().capacity() - argBlocks_.back().size() < size)
+	{
+		argBlocks_.push_back(new ValVec());
+		argBlocks_.back().reserve(std::max<size_t>(ARG_BLOCK_SIZE, size));
+	}
+	// NOTE: the arguments might be stored in the same block
+	ValVec &block = argBlocks_.back();
+	for(; first != last; ++first) { block.push_back(*first); }
+	return &block[block.size() - size];
+}
+
+void Storage::growFuncTable()
+{
+	FuncTable table(std::max<size_t>(64, 2 * funcTable_.size()), 0);
+	size_t mask = table.size() - 1;
+	for(uint32_t j = 0; j < funcs_.size(); j++)
+	{
+		size_t i = funcs_[j].hash() & mask;
+		while(table[i] != 0) { i = (i + 1) & mask; }
+		table[i] = j + 1;
+	}
+	funcTable_.swap(table);
 }
 
 const Func &Storage::func(uint32_t i) const
@@ -19,6 +19,7 @@
 #include <gringo/storage.h>
 #include <gringo/func.h>
 #include <gringo/exceptions.h>
+#include <gringo/writer.h>
 
 namespace
 {
@@ -35,7 +36,13 @@ void Val::print(Storage const *sto, std::ostream &out) const
 	{
 		case ID:     { out << sto->string(index); break; }
 		case STRING: { out << '"' << sto->quote(sto->string(index)) << '"'; break; }
-		case NUM:    { out << num; break; }
+		case NUM:
+		{
+			char buf[Writer::MAX_DIGITS];
+			char *first = Writer::format(buf + Writer::MAX_DIGITS, static_cast<int64_t>(num));
+			out.write(first, buf + Writer::MAX_DIGITS - first);
+			break;
+		}
 		case FUNC:   { sto->func(index).print(sto, out); break; }
 		case INF:    { out << "#infimum"; break; }
 		case UNDEF:  { out << "#undef"; break; }
@@ -93,7 +100,7 @@ Val Val::invert(Storage *s) const
 		case FUNC:
 		{
 			const Func &f = s->func(index);
-			return Val::func(s->index(Func(s, invertId(this, f.name(), s), f.args())));
+			return Val::func(s->index(invertId(this, f.name(), s), f.args().begin(), f.args().end()));
 		}
 		case INF:    { return Val::sup(); }
 		case SUP:    { return Val::inf(); }
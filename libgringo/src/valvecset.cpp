@@ -81,6 +81,16 @@ ValVecSet::InsertRes ValVecSet::insert(const const_iterator &v, bool fact)
 	return ValVecSet::InsertRes(*res.first, res.second);
 }
 
+void ValVecSet::truncate(uint32_t size)
+{
+	while(valSet_.size() > size)
+	{
+		Index idx((valSet_.size() - 1) * arity_);
+		valSet_.erase(idx);
+		vals_.resize(idx.index);
+	}
+}
+
 void ValVecSet::extend(const ValVecSet &other)
 {
 	foreach(const Index &idx, other.valSet_)
@@ -0,0 +1,54 @@
+// Copyright (c) 2010, Roland Kaminski <kaminski@cs.uni-potsdam.de>
+//
+// This file is part of gringo.
+//
+// gringo is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// gringo is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with gringo.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gringo/writer.h>
+
+///////////////////////////// Writer /////////////////////////////
+
+Writer::Writer(std::ostream &out)
+	: out_(out)
+	, buf_(BUFFER_SIZE)
+	, size_(0)
+{
+}
+
+void Writer::flush()
+{
+	// NOTE: std::cout synchronized with stdio hands the block to a single fwrite
+	if(size_ > 0) { out_.write(&buf_[0], size_); }
+	out_.flush();
+	size_ = 0;
+}
+
+Writer::~Writer()
+{
+	flush();
+}
+
+///////////////////////////// StringBuffer /////////////////////////////
+
+StringBuffer::int_type StringBuffer::overflow(int_type c)
+{
+	if(!traits_type::eq_int_type(c, traits_type::eof())) { str_.push_back(traits_type::to_char_type(c)); }
+	return traits_type::not_eof(c);
+}
+
+std::streamsize StringBuffer::xsputn(const char *s, std::streamsize n)
+{
+	str_.append(s, n);
+	return n;
+}
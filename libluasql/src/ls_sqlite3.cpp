@@ -25,6 +25,7 @@
 #define LUASQL_ENVIRONMENT_SQLITE "SQLite3 environment"
 #define LUASQL_CONNECTION_SQLITE "SQLite3 connection"
 #define LUASQL_CURSOR_SQLITE "SQLite3 cursor"
+#define LUASQL_STATEMENT_SQLITE "SQLite3 statement"
 
 typedef struct
 {
@@ -41,14 +42,34 @@ typedef struct
 	sqlite3      *sql_conn;
 } conn_data;
 
+/*
+** The environment table of a connection and of its prepared statements 
+** maps each prepared sql string to its statement and 1 to the connection.
+** (this way the statements do not keep a closed connection alive)
+*/
+
+
+struct cur_data;
 
 typedef struct
+{
+	short       closed;
+	int         numcols;            /* number of columns */
+	int         colnames, coltypes; /* reference to column information tables */
+	sqlite3_stmt  *sql_vm;
+	struct cur_data *cursor;        /* cursor reading the results or NULL */
+} stmt_data;
+
+
+typedef struct cur_data
 {
 	short       closed;
 	int         conn;               /* reference to connection */
 	int         numcols;            /* number of columns */
 	int         colnames, coltypes; /* reference to column information tables */
+	int         first;              /* result of the step done by execute, 0 once fetched */
 	sqlite3_stmt  *sql_vm;
+	stmt_data   *stmt;              /* prepared statement or NULL if the cursor owns sql_vm */
 } cur_data;
 
 LUASQL_API int luaopen_luasql_sqlite3(lua_State *L);
@@ -86,15 +107,58 @@ static cur_data *getcursor(lua_State *L) {
 	return cur;
 }
 
+/*
+** Check for valid prepared statement.
+*/
+static stmt_data *getstatement(lua_State *L) {
+	stmt_data *stmt = (stmt_data *)luaL_checkudata (L, 1, LUASQL_STATEMENT_SQLITE);
+	luaL_argcheck(L, stmt != NULL, 1, LUASQL_PREFIX"statement expected");
+	luaL_argcheck(L, !stmt->closed, 1, LUASQL_PREFIX"statement is closed");
+	return stmt;
+}
+
+/*
+** Detach a cursor from its prepared statement.
+** The statement is reset to be executed again, the cursor returns no more rows.
+** Return the result of the reset
+*/
+static int detach(cur_data *cur) {
+    int res = sqlite3_reset(cur->sql_vm);
+    cur->stmt->cursor = NULL;
+    cur->stmt = NULL;
+    cur->sql_vm = NULL;
+    cur->first = 0;
+    return res;
+}
+
+
+/*
+** Advance the vm of a cursor to the next row.
+** (the first row was already stepped to by execute)
+*/
+static int step(cur_data *cur) {
+    int res = cur->first;
+    cur->first = 0;
+    return res ? res : sqlite3_step(cur->sql_vm);
+}
+
+
 /*
 ** Finalizes the vm
+** (a prepared statement is only reset to be executed again)
 ** Return nil + errmsg or nil in case of sucess
 */
 static int finalize(lua_State *L, cur_data *cur) {
     const char *errmsg;
-    if (sqlite3_finalize(cur->sql_vm) != SQLITE_OK)
+    sqlite3 *db = sqlite3_db_handle(cur->sql_vm);
+    int res;
+    if (cur->stmt)
+        res = detach(cur);
+    else
+        res = sqlite3_finalize(cur->sql_vm);
+    if (res != SQLITE_OK)
     {
-        errmsg = sqlite3_errmsg(sqlite3_db_handle(cur->sql_vm));
+        errmsg = sqlite3_errmsg(db);
         cur->sql_vm = NULL;
         lua_pushnil(L);
         lua_pushliteral(L, LUASQL_PREFIX);
@@ -108,6 +172,39 @@ static int finalize(lua_State *L, cur_data *cur) {
 }
 
 
+/*
+** Copy the current row into the table at index t.
+*/
+static void copy_row(lua_State *L, cur_data *cur, int t, const char *opts)
+{
+	sqlite3_stmt *vm = cur->sql_vm;
+	int i;
+
+	if (strchr(opts, 'n') != NULL)
+	{
+		/* Copy values to numerical indices */
+		for (i = 0; i < cur->numcols;)
+		{
+			lua_pushstring(L, (const char *)sqlite3_column_text(vm, i));
+			lua_rawseti(L, t, ++i);
+		}
+	}
+	if (strchr(opts, 'a') != NULL)
+	{
+		/* Copy values to alphanumerical indices */
+		lua_rawgeti(L, LUA_REGISTRYINDEX, cur->colnames);
+
+		for (i = 0; i < cur->numcols; i++)
+		{
+			lua_rawgeti(L, -1, i+1);
+			lua_pushstring(L, (const char*)sqlite3_column_text(vm,i));
+			lua_rawset (L, t);
+		}
+		lua_pop(L, 1);
+	}
+}
+
+
 /*
 ** Get another row of the given cursor.
 */
@@ -119,7 +216,7 @@ static int cur_fetch (lua_State *L) {
     if (vm == NULL)
         return 0;
 
-    res = sqlite3_step(vm);
+    res = step(cur);
 
     /* no more results? */
     if (res == SQLITE_DONE)
@@ -130,30 +227,7 @@ static int cur_fetch (lua_State *L) {
 
 	if (lua_istable (L, 2))
     {
-		int i;
-		const char *opts = luaL_optstring(L, 3, "n");
-
-		if (strchr(opts, 'n') != NULL)
-        {
-			/* Copy values to numerical indices */
-			for (i = 0; i < cur->numcols;)
-            {
-	            lua_pushstring(L, (const char *)sqlite3_column_text(vm, i));
-				lua_rawseti(L, 2, ++i);
-			}
-        }
-		if (strchr(opts, 'a') != NULL)
-        {
-			/* Copy values to alphanumerical indices */
-            lua_rawgeti(L, LUA_REGISTRYINDEX, cur->colnames);
-
-			for (i = 0; i < cur->numcols; i++)
-            {
-				lua_rawgeti(L, -1, i+1);
-				lua_pushstring(L, (const char*)sqlite3_column_text(vm,i));
-				lua_rawset (L, 2);
-			}
-        }
+		copy_row(L, cur, 2, luaL_optstring(L, 3, "n"));
 		lua_pushvalue(L, 2);
 		return 1; /* return table */
 	}
@@ -168,6 +242,43 @@ static int cur_fetch (lua_State *L) {
 }
 
 
+/*
+** Get up to n rows of the given cursor.
+** Return a table with one table per row or nil if there are no more rows.
+*/
+static int cur_fetchmany (lua_State *L) {
+    cur_data *cur = getcursor(L);
+    int n = luaL_checkint(L, 2);
+    const char *opts = luaL_optstring(L, 3, "n");
+    int rows = 0;
+    int res;
+
+    luaL_argcheck(L, n > 0, 2, LUASQL_PREFIX"positive number of rows expected");
+    if (cur->sql_vm == NULL)
+        return 0;
+
+    lua_createtable(L, n, 0);
+    while (rows < n)
+    {
+        res = step(cur);
+        if (res != SQLITE_ROW)
+        {
+            int ret = finalize(L, cur);
+            /* report errors and the end of the results only without pending rows */
+            if (ret > 1 || rows == 0)
+                return ret;
+            lua_pop(L, ret);
+            break;
+        }
+        lua_createtable(L, (strchr(opts, 'n') != NULL) ? cur->numcols : 0, 
+            (strchr(opts, 'a') != NULL) ? cur->numcols : 0);
+        copy_row(L, cur, lua_gettop(L), opts);
+        lua_rawseti(L, -2, ++rows);
+    }
+    return 1;
+}
+
+
 /*
 ** Close the cursor on top of the stack.
 ** Return 1
@@ -184,7 +295,10 @@ static int cur_close(lua_State *L)
 
 	/* Nullify structure fields. */
 	cur->closed = 1;
-	sqlite3_finalize(cur->sql_vm);
+	if (cur->stmt)
+		detach(cur);
+	else
+		sqlite3_finalize(cur->sql_vm);
 	/* Decrement cursor counter on connection object */
 	lua_rawgeti (L, LUA_REGISTRYINDEX, cur->conn);
 	conn = (conn_data*)lua_touserdata (L, -1);
@@ -221,15 +335,43 @@ static int cur_getcoltypes(lua_State *L)
 }
 
 
+/*
+** Create the tables with column names and types of a vm.
+*/
+static void create_colinfo(lua_State *L, sqlite3_stmt *sql_vm, int numcols, 
+		int *colnames, int *coltypes)
+{
+    int i;
+
+    /* create table with column names */
+    lua_newtable(L);
+    for (i = 0; i < numcols;)
+    {
+        lua_pushstring(L, sqlite3_column_name(sql_vm, i));
+        lua_rawseti(L, -2, ++i);
+    }
+    *colnames = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    /* create table with column types */
+    lua_newtable(L);
+    for (i = 0; i < numcols;)
+    {
+        lua_pushstring(L, sqlite3_column_decltype(sql_vm, i));
+        lua_rawseti(L, -2, ++i);
+    }
+    *coltypes = luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+
 /*
 ** Create a new Cursor object and push it on top of the stack.
+** The vm has already been stepped once with result first.
+** If stmt is not NULL the cursor reads the results of the prepared 
+** statement and refers to its column information tables.
 */
-/* static int create_cursor(lua_State *L, int conn, sqlite3_stmt *sql_vm,
-    int numcols, const char **row, const char **col_info)*/
 static int create_cursor(lua_State *L, int o, conn_data *conn, 
-		sqlite3_stmt *sql_vm, int numcols)
+		sqlite3_stmt *sql_vm, int numcols, int first, stmt_data *stmt)
 {
-    int i;
 	cur_data *cur = (cur_data*)lua_newuserdata(L, sizeof(cur_data));
 	luasql_setmeta (L, LUASQL_CURSOR_SQLITE);
 
@@ -242,29 +384,168 @@ static int create_cursor(lua_State *L, int o, conn_data *conn,
 	cur->numcols = numcols;
 	cur->colnames = LUA_NOREF;
 	cur->coltypes = LUA_NOREF;
+	cur->first = first;
 	cur->sql_vm = sql_vm;
+	cur->stmt = stmt;
 
     lua_pushvalue(L, o);
 	cur->conn = luaL_ref(L, LUA_REGISTRYINDEX);
 
-    /* create table with column names */
-    lua_newtable(L);
-    for (i = 0; i < numcols;)
+	if (stmt)
+	{
+		stmt->cursor = cur;
+		/* own references, the statement may be closed before the cursor */
+		lua_rawgeti(L, LUA_REGISTRYINDEX, stmt->colnames);
+		cur->colnames = luaL_ref(L, LUA_REGISTRYINDEX);
+		lua_rawgeti(L, LUA_REGISTRYINDEX, stmt->coltypes);
+		cur->coltypes = luaL_ref(L, LUA_REGISTRYINDEX);
+	}
+	else
+		create_colinfo(L, sql_vm, numcols, &cur->colnames, &cur->coltypes);
+
+	return 1;
+}
+
+
+/*
+** Release the vm and the column information of a prepared statement.
+*/
+static void finalize_statement(lua_State *L, stmt_data *stmt)
+{
+	if (stmt->cursor)
+		detach(stmt->cursor);
+	/* Nullify structure fields. */
+	stmt->closed = 1;
+	sqlite3_finalize(stmt->sql_vm);
+	stmt->sql_vm = NULL;
+	luaL_unref(L, LUA_REGISTRYINDEX, stmt->colnames);
+	luaL_unref(L, LUA_REGISTRYINDEX, stmt->coltypes);
+}
+
+
+/*
+** Close a prepared statement.
+*/
+static int stmt_close(lua_State *L)
+{
+	stmt_data *stmt = (stmt_data *)luaL_checkudata(L, 1, LUASQL_STATEMENT_SQLITE);
+	luaL_argcheck(L, stmt != NULL, 1, LUASQL_PREFIX"statement expected");
+	if (stmt->closed) 
+	{
+		lua_pushboolean(L, 0);
+		return 1;
+	}
+
+	finalize_statement(L, stmt);
+	lua_pushboolean(L, 1);
+	return 1;
+}
+
+
+/*
+** Execute a prepared statement binding the arguments to its parameters.
+** Numbers without fractional part are bound as integers, booleans as 0/1.
+** A cursor still reading the results of a previous execution is detached.
+** Return a Cursor object if the statement is a query, otherwise
+** return the number of tuples affected by the statement.
+*/
+static int stmt_execute(lua_State *L)
+{
+    stmt_data *stmt = getstatement(L);
+    sqlite3_stmt *vm = stmt->sql_vm;
+    sqlite3 *db = sqlite3_db_handle(vm);
+    conn_data *conn;
+    int top = lua_gettop(L);
+    int res = SQLITE_OK;
+    int i;
+
+    luaL_argcheck(L, top - 1 <= sqlite3_bind_parameter_count(vm), top, 
+        LUASQL_PREFIX"too many parameters");
+
+    if (stmt->cursor)
+        detach(stmt->cursor);
+    sqlite3_clear_bindings(vm);
+    for (i = 2; i <= top && res == SQLITE_OK; i++)
     {
-        lua_pushstring(L, sqlite3_column_name(sql_vm, i));
-        lua_rawseti(L, -2, ++i);
+        switch (lua_type(L, i))
+        {
+            case LUA_TNIL:
+                res = sqlite3_bind_null(vm, i - 1);
+                break;
+            case LUA_TBOOLEAN:
+                res = sqlite3_bind_int(vm, i - 1, lua_toboolean(L, i));
+                break;
+            case LUA_TNUMBER:
+            {
+                lua_Number num = lua_tonumber(L, i);
+                if (num == (lua_Number)(sqlite3_int64)num)
+                    res = sqlite3_bind_int64(vm, i - 1, (sqlite3_int64)num);
+                else
+                    res = sqlite3_bind_double(vm, i - 1, num);
+                break;
+            }
+            case LUA_TSTRING:
+            {
+                size_t len;
+                const char *str = lua_tolstring(L, i, &len);
+                res = sqlite3_bind_text(vm, i - 1, str, (int)len, SQLITE_TRANSIENT);
+                break;
+            }
+            default:
+                return luaL_argerror(L, i, LUASQL_PREFIX"nil, boolean, number or string expected");
+        }
     }
-    cur->colnames = luaL_ref(L, LUA_REGISTRYINDEX);
 
-    /* create table with column types */
-    lua_newtable(L);
-    for (i = 0; i < numcols;)
+    if (res == SQLITE_OK)
     {
-        lua_pushstring(L, sqlite3_column_decltype(sql_vm, i));
-        lua_rawseti(L, -2, ++i);
+        res = sqlite3_step(vm);
+
+        /* real query? if empty, must have numcols!=0 */
+        if ((res == SQLITE_ROW) || ((res == SQLITE_DONE) && stmt->numcols))
+        {
+            lua_getfenv(L, 1);
+            lua_rawgeti(L, -1, 1);
+            conn = (conn_data *)lua_touserdata(L, -1);
+            return create_cursor(L, lua_gettop(L), conn, vm, stmt->numcols, res, stmt);
+        }
+
+        if (res == SQLITE_DONE) /* and numcols==0, INSERT,UPDATE,DELETE statement */
+        {
+            sqlite3_reset(vm);
+            /* return number of columns changed */
+            lua_pushnumber(L, sqlite3_changes(db));
+            return 1;
+        }
     }
-    cur->coltypes = luaL_ref(L, LUA_REGISTRYINDEX);
 
+    /* error */
+    sqlite3_reset(vm);
+    lua_pushnil(L);
+    lua_pushliteral(L, LUASQL_PREFIX);
+    lua_pushstring(L, sqlite3_errmsg(db));
+    lua_concat(L, 2);
+    return 2;
+}
+
+
+/*
+** Return the list of field names.
+*/
+static int stmt_getcolnames(lua_State *L)
+{
+    stmt_data *stmt = getstatement(L);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, stmt->colnames);
+	return 1;
+}
+
+
+/*
+** Return the list of field types.
+*/
+static int stmt_getcoltypes(lua_State *L)
+{
+    stmt_data *stmt = getstatement(L);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, stmt->coltypes);
 	return 1;
 }
 
@@ -285,6 +566,23 @@ static int conn_close(lua_State *L)
 	if (conn->cur_counter > 0)
 		return luaL_error (L, LUASQL_PREFIX"there are open cursors");
 
+	/* finalize cached statements, otherwise the database cannot be closed */
+	lua_getfenv(L, 1);
+	lua_pushnil(L);
+	while (lua_next(L, -2) != 0)
+	{
+		if (lua_type(L, -2) == LUA_TSTRING)
+		{
+			stmt_data *stmt = (stmt_data *)lua_touserdata(L, -1);
+			if (!stmt->closed)
+				finalize_statement(L, stmt);
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+	lua_newtable(L);
+	lua_setfenv(L, 1);
+
 	/* Nullify structure fields. */
 	conn->closed = 1;
 	luaL_unref(L, LUA_REGISTRYINDEX, conn->env);
@@ -341,10 +639,7 @@ static int conn_execute(lua_State *L)
 
     /* real query? if empty, must have numcols!=0 */
 	if ((res == SQLITE_ROW) || ((res == SQLITE_DONE) && numcols))
-	{
-		sqlite3_reset(vm);
-		return create_cursor(L, 1, conn, vm, numcols);
-	}
+		return create_cursor(L, 1, conn, vm, numcols, res, NULL);
 
     if (res == SQLITE_DONE) /* and numcols==0, INSERT,UPDATE,DELETE statement */
     {
@@ -365,6 +660,59 @@ static int conn_execute(lua_State *L)
 }
 
 
+/*
+** Return the prepared statement for an SQL statement.
+** Statements are cached per connection; preparing the same sql string 
+** again returns the cached statement.
+*/
+static int conn_prepare(lua_State *L)
+{
+    conn_data *conn = getconnection(L);
+    size_t len;
+    const char *statement = luaL_checklstring(L, 2, &len);
+    stmt_data *stmt;
+    sqlite3_stmt *vm;
+    const char *tail;
+    int res;
+
+    lua_getfenv(L, 1);
+    lua_pushvalue(L, 2);
+    lua_rawget(L, -2);
+    if (!lua_isnil(L, -1) && !((stmt_data *)lua_touserdata(L, -1))->closed)
+        return 1;
+    lua_pop(L, 1);
+
+    /* the v2 interface prepares the statement again if the schema changes */
+    res = sqlite3_prepare_v2(conn->sql_conn, statement, (int)len, &vm, &tail);
+    if (res != SQLITE_OK)
+    {
+        lua_pushnil(L);
+        lua_pushliteral(L, LUASQL_PREFIX);
+        lua_pushstring(L, sqlite3_errmsg(conn->sql_conn));
+        lua_concat(L, 2);
+        return 2;
+    }
+
+    stmt = (stmt_data *)lua_newuserdata(L, sizeof(stmt_data));
+    luasql_setmeta(L, LUASQL_STATEMENT_SQLITE);
+
+	/* fill in structure */
+	stmt->closed = 0;
+	stmt->cursor = NULL;
+	stmt->numcols = sqlite3_column_count(vm);
+	stmt->sql_vm = vm;
+	create_colinfo(L, vm, stmt->numcols, &stmt->colnames, &stmt->coltypes);
+
+    /* share the environment with the connection and remember the statement */
+    lua_pushvalue(L, -2);
+    lua_setfenv(L, -2);
+    lua_pushvalue(L, 2);
+    lua_pushvalue(L, -2);
+    lua_rawset(L, -4);
+    return 1;
+}
+
+
 /*
 ** Commit the current transaction.
 */
@@ -477,6 +825,12 @@ static int create_connection(lua_State *L, int env, sqlite3 *sql_conn)
 	conn->cur_counter = 0;
 	lua_pushvalue (L, env);
 	conn->env = luaL_ref (L, LUA_REGISTRYINDEX);
+
+	/* table of prepared statements */
+	lua_newtable(L);
+	lua_pushvalue(L, -2);
+	lua_rawseti(L, -2, 1);
+	lua_setfenv(L, -2);
 	return 1;
 }
 
@@ -540,6 +894,7 @@ static void create_metatables (lua_State *L)
         {"close", conn_close},
         {"escape", conn_escape},
         {"execute", conn_execute},
+        {"prepare", conn_prepare},
         {"commit", conn_commit},
         {"rollback", conn_rollback},
         {"setautocommit", conn_setautocommit},
@@ -551,12 +906,21 @@ static void create_metatables (lua_State *L)
         {"getcolnames", cur_getcolnames},
         {"getcoltypes", cur_getcoltypes},
         {"fetch", cur_fetch},
+        {"fetchmany", cur_fetchmany},
+		{NULL, NULL},
+    };
+    struct luaL_reg statement_methods[] = {
+        {"close", stmt_close},
+        {"execute", stmt_execute},
+        {"getcolnames", stmt_getcolnames},
+        {"getcoltypes", stmt_getcoltypes},
 		{NULL, NULL},
     };
 	luasql_createmeta(L, LUASQL_ENVIRONMENT_SQLITE, environment_methods);
 	luasql_createmeta(L, LUASQL_CONNECTION_SQLITE, connection_methods);
 	luasql_createmeta(L, LUASQL_CURSOR_SQLITE, cursor_methods);
-	lua_pop (L, 3);
+	luasql_createmeta(L, LUASQL_STATEMENT_SQLITE, statement_methods);
+	lua_pop (L, 4);
 }
 
 /*